@@ -0,0 +1 @@
+from .compile_pipeline import benchmark
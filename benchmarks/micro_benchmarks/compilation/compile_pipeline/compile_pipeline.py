@@ -0,0 +1,104 @@
+import os
+import statistics
+import time
+
+import torch
+import intel_extension_for_pytorch  # type: ignore # noqa: F401
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def add_kernel(x_ptr, y_ptr, output_ptr, n_elements, BLOCK_SIZE: tl.constexpr):
+    offsets = tl.program_id(0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+    x = tl.load(x_ptr + offsets, mask=mask)
+    y = tl.load(y_ptr + offsets, mask=mask)
+    tl.store(output_ptr + offsets, x + y, mask=mask)
+
+
+@triton.jit
+def softmax_kernel(output_ptr, input_ptr, n_cols, BLOCK_SIZE: tl.constexpr):
+    row = tl.program_id(0)
+    offsets = tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_cols
+    x = tl.load(input_ptr + row * n_cols + offsets, mask=mask, other=-float('inf'))
+    num = tl.exp(x - tl.max(x, axis=0))
+    tl.store(output_ptr + row * n_cols + offsets, num / tl.sum(num, axis=0), mask=mask)
+
+
+@triton.jit
+def matmul_kernel(a_ptr, b_ptr, c_ptr, M, N, K, BLOCK_M: tl.constexpr, BLOCK_N: tl.constexpr,
+                  BLOCK_K: tl.constexpr):
+    offs_m = tl.program_id(0) * BLOCK_M + tl.arange(0, BLOCK_M)
+    offs_n = tl.program_id(1) * BLOCK_N + tl.arange(0, BLOCK_N)
+    offs_k = tl.arange(0, BLOCK_K)
+    a_ptrs = a_ptr + offs_m[:, None] * K + offs_k[None, :]
+    b_ptrs = b_ptr + offs_k[:, None] * N + offs_n[None, :]
+    acc = tl.zeros((BLOCK_M, BLOCK_N), dtype=tl.float32)
+    for _ in range(0, K, BLOCK_K):
+        acc += tl.dot(tl.load(a_ptrs), tl.load(b_ptrs))
+        a_ptrs += BLOCK_K
+        b_ptrs += BLOCK_K * N
+    tl.store(c_ptr + offs_m[:, None] * N + offs_n[None, :], acc)
+
+
+# kernel: (function, signature, constants)
+CORPUS = {
+    'add': (add_kernel, {0: '*fp32', 1: '*fp32', 2: '*fp32', 3: 'i32'}, {'BLOCK_SIZE': 1024}),
+    'softmax': (softmax_kernel, {0: '*fp32', 1: '*fp32', 2: 'i32'}, {'BLOCK_SIZE': 1024}),
+    'matmul': (matmul_kernel, {0: '*fp16', 1: '*fp16', 2: '*fp32', 3: 'i32', 4: 'i32', 5: 'i32'},
+               {'BLOCK_M': 128, 'BLOCK_N': 128, 'BLOCK_K': 32}),
+}
+
+# mode: (environment, options)
+MODES = {
+    'full': ({'TRITON_INTEL_FULL_TTGIR_PIPELINE': '1'}, {}),
+    'default': ({'TRITON_INTEL_FULL_TTGIR_PIPELINE': '0'}, {}),
+    'O1': ({'TRITON_INTEL_FULL_TTGIR_PIPELINE': '0'}, {'opt_level': 1}),
+}
+
+
+def compile_kernel(kernel, options):
+    fn, signature, constants = CORPUS[kernel]
+    src = triton.compiler.ASTSource(fn=fn, signature=signature, constants=constants)
+    triton.compile(src, target=triton.runtime.driver.active.get_current_target(), options=options)
+
+
+@triton.testing.perf_report(
+    triton.testing.Benchmark(
+        x_names=['kernel'],
+        x_vals=list(CORPUS),
+        line_arg='mode',
+        line_vals=list(MODES),
+        line_names=['Full pipeline', 'Skipped passes', 'O1'],
+        styles=[('blue', '-'), ('green', '-'), ('red', '-')],
+        ylabel='compile time (ms)',
+        plot_name='compile-pipeline',
+        args={},
+    ))
+def benchmark(kernel, mode, repeats=5):
+    env, options = MODES[mode]
+    env = {**env, 'TRITON_ALWAYS_COMPILE': '1'}
+    saved_env = {name: os.environ.get(name) for name in env}
+    os.environ.update(env)
+    try:
+        # warm up the lazily loaded modules
+        compile_kernel(kernel, options)
+        times = []
+        for _ in range(repeats):
+            start = time.perf_counter()
+            compile_kernel(kernel, options)
+            times.append(time.perf_counter() - start)
+    finally:
+        for name, value in saved_env.items():
+            if value is None:
+                os.environ.pop(name, None)
+            else:
+                os.environ[name] = value
+    return statistics.median(times) * 1000
+
+
+if __name__ == "__main__":
+    benchmark.run(print_data=True)
@@ -0,0 +1 @@
+from .compile_throughput import benchmark
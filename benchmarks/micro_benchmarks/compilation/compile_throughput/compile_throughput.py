@@ -0,0 +1,73 @@
+import os
+import time
+
+import torch
+import intel_extension_for_pytorch  # type: ignore # noqa: F401
+
+import triton
+import triton.language as tl
+
+
+@triton.jit
+def softmax_kernel(
+    output_ptr,
+    input_ptr,
+    n_cols,
+    BLOCK_SIZE: tl.constexpr,
+    SCALE: tl.constexpr,
+):
+    row = tl.program_id(0)
+    offsets = tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_cols
+    x = tl.load(input_ptr + row * n_cols + offsets, mask=mask, other=-float('inf'))
+    x = x * SCALE
+    x = x - tl.max(x, axis=0)
+    num = tl.exp(x)
+    tl.store(output_ptr + row * n_cols + offsets, num / tl.sum(num, axis=0), mask=mask)
+
+
+def compile_variants(num_variants):
+    # Every variant has a different SCALE, so each one is a separate compilation, as when autotuning.
+    target = triton.runtime.driver.active.get_current_target()
+    for scale in range(1, num_variants + 1):
+        src = triton.compiler.ASTSource(
+            fn=softmax_kernel,
+            signature={0: '*fp32', 1: '*fp32', 2: 'i32'},
+            constants={'BLOCK_SIZE': 1024, 'SCALE': scale},
+        )
+        triton.compile(src, target=target)
+
+
+@triton.testing.perf_report(
+    triton.testing.Benchmark(
+        x_names=['num_variants'],
+        x_vals=[4, 8, 16, 32],
+        line_arg='context_pool',
+        line_vals=['1', '0'],
+        line_names=['Context pool', 'Fresh contexts'],
+        styles=[('blue', '-'), ('green', '-')],
+        ylabel='compilations/s',
+        plot_name='compile-throughput',
+        args={},
+    ))
+def benchmark(num_variants, context_pool):
+    env = {'TRITON_CONTEXT_POOL': context_pool, 'TRITON_ALWAYS_COMPILE': '1'}
+    saved_env = {name: os.environ.get(name) for name in env}
+    os.environ.update(env)
+    try:
+        # warm up the pool and the lazily loaded modules
+        compile_variants(1)
+        start = time.perf_counter()
+        compile_variants(num_variants)
+        elapsed = time.perf_counter() - start
+    finally:
+        for name, value in saved_env.items():
+            if value is None:
+                os.environ.pop(name, None)
+            else:
+                os.environ[name] = value
+    return num_variants / elapsed
+
+
+if __name__ == "__main__":
+    benchmark.run(print_data=True)
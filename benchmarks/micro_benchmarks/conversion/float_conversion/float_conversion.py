@@ -29,6 +29,38 @@ def float_trunc_kernel(
     tl.store(x_ptr + offsets, as_f32, mask=mask)
 
 
+@triton.jit
+def float8_upcast_kernel(
+    x_ptr,
+    y_ptr,
+    n_elements,
+    BLOCK_SIZE: tl.constexpr,
+    src_type: tl.constexpr,
+):
+    pid = tl.program_id(axis=0)
+    block_start = pid * BLOCK_SIZE
+    offsets = block_start + tl.arange(0, BLOCK_SIZE)
+    mask = offsets < n_elements
+
+    bits = tl.load(x_ptr + offsets, mask=mask)
+
+    acc = tl.zeros([BLOCK_SIZE], dtype=tl.float16)
+    for i in range(100):
+        # flipping the bits ensures that every iteration converts different values
+        as_src = (bits ^ i.to(tl.uint8)).to(src_type, bitcast=True)
+        acc += as_src.to(tl.float16)
+
+    tl.store(y_ptr + offsets, acc, mask=mask)
+
+
+def launch_float8_upcast(x: torch.Tensor, y: torch.Tensor, src_type: type):
+    assert x.is_xpu and x.dtype == torch.uint8
+    n_elements = x.numel()
+    grid = lambda meta: (triton.cdiv(n_elements, meta['BLOCK_SIZE']), )
+    float8_upcast_kernel[grid](x, y, n_elements, BLOCK_SIZE=1024, src_type=src_type)
+    return y
+
+
 def launch_conversion(x: torch.Tensor, target_type: type):
     assert x.is_xpu
     n_elements = x.numel()
@@ -37,20 +69,39 @@ def launch_conversion(x: torch.Tensor, target_type: type):
     return x
 
 
+# FP8 formats benchmarked by upcasting to FP16.
+FLOAT8_TYPES = {
+    'float8e4b15': tl.float8e4b15,
+    'float8e4nv': tl.float8e4nv,
+    'float8e4b8': tl.float8e4b8,
+    'float8e5': tl.float8e5,
+    'float8e5b16': tl.float8e5b16,
+}
+
+
 @triton.testing.perf_report(
     triton.testing.Benchmark(
         x_names=['N'],
         x_vals=[2**i for i in range(12, 28, 2)],
         line_arg='target_type',
-        line_vals=['bfloat16', 'float16'],
-        line_names=['BF16', 'FP16'],
-        styles=[('blue', '-'), ('green', '-'), ('orange', '-')],
+        line_vals=['bfloat16', 'float16'] + list(FLOAT8_TYPES),
+        line_names=['BF16', 'FP16', 'FP8E4B15', 'FP8E4NV', 'FP8E4B8', 'FP8E5', 'FP8E5B16'],
+        styles=[('blue', '-'), ('green', '-'), ('orange', '-'), ('red', '-'), ('purple', '-'), ('brown', '-'),
+                ('gray', '-')],
         ylabel='GB/s',
         plot_name='float-conversion',
         args={},
     ))
 def benchmark(N, target_type):
     quantiles = [0.5, 0.2, 0.8]
+    if target_type in FLOAT8_TYPES:
+        inputs = torch.randint(0, 256, (N, ), dtype=torch.uint8, device='xpu')
+        outputs = torch.empty(N, dtype=torch.float16, device='xpu')
+        fwd = lambda: launch_float8_upcast(inputs, outputs, FLOAT8_TYPES[target_type])
+        ms, min_ms, max_ms = triton.testing.do_bench(fwd, quantiles=quantiles)
+        gbps = lambda ms: (inputs.numel() * (inputs.element_size() + outputs.element_size()) * 1e-9) / (ms * 1e-3)
+        return gbps(ms), gbps(max_ms), gbps(min_ms)
+
     inputs = torch.rand(N, dtype=torch.float32, device='xpu', requires_grad=True)
 
     if target_type == "bfloat16":
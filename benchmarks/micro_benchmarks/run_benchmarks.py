@@ -1,5 +1,6 @@
 import argparse
 
+from compilation import compile_pipeline, compile_throughput
 from conversion import float_conversion
 
 if __name__ == "__main__":
@@ -12,3 +13,5 @@ if __name__ == "__main__":
     )
     args = parser.parse_args()
     float_conversion.benchmark.run(print_data=True, save_path=args.reports)
+    compile_throughput.benchmark.run(print_data=True, save_path=args.reports)
+    compile_pipeline.benchmark.run(print_data=True, save_path=args.reports)
@@ -124,6 +124,8 @@ import xetla_benchmark.xetla_kernel as xetla_kernel
                       num_warps=32),
     ],
     key=['M', 'N', 'K'],
+    # Stream-K kernels accumulate partial tiles into the output.
+    reset_to_zero=['c_ptr'],
 )
 @triton.jit
 def matmul_kernel_with_block_pointers(
@@ -199,15 +201,17 @@ def matmul_kernel_with_block_pointers(
 
 # We can now create a convenience wrapper function that only takes two input tensors,
 # and (1) checks any shape constraint; (2) allocates the output; (3) launches the above kernel.
-def matmul(a, b):
+def matmul(a, b, stream_k=False, c=None):
     # Check constraints.
     assert a.shape[1] == b.shape[0], "Incompatible dimensions"
     assert a.is_contiguous(), "Matrix A must be contiguous"
     assert b.is_contiguous(), "Matrix B must be contiguous"
     M, K = a.shape
     K, N = b.shape
-    # Allocates output.
-    c = torch.empty((M, N), device=a.device, dtype=torch.float32)
+    # Allocates output, unless provided. With Stream-K, the tiles split across several programs
+    # are accumulated into the output with atomic additions, so it must start from zero.
+    if c is None:
+        c = (torch.zeros if stream_k else torch.empty)((M, N), device=a.device, dtype=torch.float32)
     # 1D launch kernel where each block gets its own program.
     grid = lambda META: (triton.cdiv(M, META['BLOCK_SIZE_M']) * triton.cdiv(N, META['BLOCK_SIZE_N']), )
     matmul_kernel_with_block_pointers[grid](
@@ -216,7 +220,7 @@ def matmul(a, b):
         a.stride(0), a.stride(1),  #
         b.stride(0), b.stride(1),  #
         c.stride(0), c.stride(1),  #
-        threads_per_warp=16)
+        threads_per_warp=16, stream_k=stream_k)
     return c
 
 
@@ -229,13 +233,18 @@ def matmul(a, b):
             # [4096, 4096, 4096],
             # [2048,2048,2048],
             [256 * i, 256 * i, 256 * i] for i in range(1, 17)
+        ] + [
+            # skewed shapes, whose last wave of tiles leaves Xe cores idle
+            [512, 8192, 8192],
+            [1024, 3072, 16384],
+            [3072, 1024, 16384],
         ],  # different possible values for `x_name`
         line_arg='provider',
         # argument name whose value corresponds to a different line in the plot
         # possible values for `line_arg``
-        line_vals=['onednn', 'triton', 'xetla'],
+        line_vals=['onednn', 'triton', 'triton-fp8', 'triton-stream-k', 'xetla'],
         # label name for the lines
-        line_names=["oneDNN", "Triton", "Xetla"],
+        line_names=["oneDNN", "Triton", "Triton FP8", "Triton Stream-K", "Xetla"],
         # line styles
         #styles=[('green', '-'), ('green', '--'), ('blue', '-'), ('blue', '--')],
         ylabel="TFLOPS",  # label name for the y-axis
@@ -259,12 +268,30 @@ def benchmark(M, N, K, provider):
     if provider == 'triton':
         ms, min_ms, max_ms = triton.testing.do_bench(lambda: matmul(a, b), warmup=10, rep=10, quantiles=quantiles,
                                                      fast_flush=False)
+    if provider == 'triton-fp8':
+        # fp8 operands are upconverted to fp16 in registers before being fed to DPAS.
+        a_fp8 = a.to(torch.float8_e5m2)
+        b_fp8 = b.to(torch.float8_e5m2)
+        ms, min_ms, max_ms = triton.testing.do_bench(lambda: matmul(a_fp8, b_fp8), warmup=10, rep=10,
+                                                     quantiles=quantiles, fast_flush=False)
+    if provider == 'triton-stream-k':
+        # The tiles split across several programs are accumulated into the output with atomic additions, so each
+        # timed call zeroes the output first.
+        c = torch.empty((M, N), device='xpu', dtype=torch.float32)
+        triton_fn = lambda: matmul(a, b, stream_k=True, c=c.zero_())
+        torch_fn = lambda: torch.matmul(a, b).to(torch.float32)
+        xetla_benchmark.assert_close(triton_fn(), torch_fn(), atol=1e-1, rtol=1e-2, err_msg="triton to torch")
+        ms, min_ms, max_ms = triton.testing.do_bench(triton_fn, warmup=10, rep=10, quantiles=quantiles,
+                                                     fast_flush=False)
     if provider == 'xetla':
         c = torch.empty((M, N), device='xpu', dtype=torch.float16)
         d = torch.empty((M, N), device='xpu', dtype=torch.float16)
         cnt = torch.empty((M, N), device='xpu', dtype=torch.int32)
         name = "bgemm_shape_{}_{}_{}".format(M, N, K)
-        func = getattr(xetla_kernel, name)
+        func = getattr(xetla_kernel, name, None)
+        if func is None:
+            # No XeTLA kernel is instantiated for this shape.
+            return float('nan'), float('nan'), float('nan')
         ms, min_ms, max_ms = triton.testing.do_bench(lambda: func(a, b, c, d, cnt), warmup=10, rep=10,
                                                      quantiles=quantiles, fast_flush=False)
 
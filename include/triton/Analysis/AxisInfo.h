@@ -152,14 +152,22 @@ private:
   std::optional<int64_t> constantValue;
 };
 
+using AxisInfoMapT = DenseMap<Value, AxisInfo>;
+
+// Runs the axis info analysis on a single function and returns the axis info
+// of its results and block arguments.  The facts known about the function
+// arguments are read from their `tt.contiguity`, `tt.divisibility` and
+// `tt.constancy` attributes.
+AxisInfoMapT computeFuncAxisInfo(FunctionOpInterface funcOp);
+
 // Module level axis info analysis based on the call graph, assuming that we do
 // not have recursive functions.
 //
 // Since each function will be called multiple times, we need to calculate the
-// axis info based on the axis info of all the callers.  In the future, we can
-// perform optimization using function cloning so that each call site will have
-// unique axis info.
-using AxisInfoMapT = DenseMap<Value, AxisInfo>;
+// axis info based on the axis info of all the callers.  Run the
+// `triton-specialize-call-sites` pass beforehand to clone the functions whose
+// call sites have different axis info, so that each clone only sees the
+// callers it is specialized for.
 class ModuleAxisInfoAnalysis : public CallGraph<AxisInfoMapT> {
 public:
   explicit ModuleAxisInfoAnalysis(ModuleOp moduleOp)
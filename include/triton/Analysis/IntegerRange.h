@@ -0,0 +1,91 @@
+#ifndef TRITON_ANALYSIS_INTEGERRANGE_H
+#define TRITON_ANALYSIS_INTEGERRANGE_H
+
+#include "mlir/Analysis/DataFlow/SparseAnalysis.h"
+#include "mlir/Interfaces/InferIntRangeInterface.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "mlir/Support/LLVM.h"
+
+#include <optional>
+
+namespace mlir::triton {
+
+//===----------------------------------------------------------------------===//
+// IntegerRange
+//===----------------------------------------------------------------------===//
+
+/// This lattice value represents the range of the integer elements of a value:
+/// all the elements of a tensor lie in the range.
+class IntegerRange {
+public:
+  IntegerRange() = default;
+  IntegerRange(const ConstantIntRanges &range) : range(range) {}
+
+  bool isUninitialized() const { return !range.has_value(); }
+
+  const ConstantIntRanges &getRange() const {
+    assert(!isUninitialized() && "range is uninitialized");
+    return *range;
+  }
+
+  bool operator==(const IntegerRange &other) const {
+    return range == other.range;
+  }
+
+  /// The pessimistic state of a value with integer elements is the range of
+  /// its element type.  Other values stay uninitialized.
+  static IntegerRange getPessimisticValueState(Value value);
+
+  static IntegerRange join(const IntegerRange &lhs, const IntegerRange &rhs);
+
+  void print(raw_ostream &os) const {
+    if (isUninitialized())
+      os << "<uninitialized>";
+    else
+      os << *range;
+  }
+
+private:
+  std::optional<ConstantIntRanges> range;
+};
+
+//===----------------------------------------------------------------------===//
+// IntegerRangeAnalysis
+//===----------------------------------------------------------------------===//
+
+/// Computes the range of the integer values of a function, tensors included.
+///
+/// The arith operations are handled through `InferIntRangeInterface`, while
+/// `tt.make_range`, `tt.get_program_id` and `tt.get_num_programs` provide the
+/// bounds the ranges are built from.  Shape manipulations (`tt.splat`,
+/// `tt.broadcast`, ...) preserve the range of their operand and the induction
+/// variable of a `scf.for` loop ranges over the loop bounds.
+class IntegerRangeAnalysis : public dataflow::SparseForwardDataFlowAnalysis<
+                                 dataflow::Lattice<IntegerRange>> {
+public:
+  using dataflow::SparseForwardDataFlowAnalysis<
+      dataflow::Lattice<IntegerRange>>::SparseForwardDataFlowAnalysis;
+
+  void
+  visitOperation(Operation *op,
+                 ArrayRef<const dataflow::Lattice<IntegerRange> *> operands,
+                 ArrayRef<dataflow::Lattice<IntegerRange> *> results) override;
+
+private:
+  void setToEntryState(dataflow::Lattice<IntegerRange> *lattice) override;
+
+  void visitNonControlFlowArguments(
+      Operation *op, const RegionSuccessor &successor,
+      ArrayRef<dataflow::Lattice<IntegerRange> *> argLattices,
+      unsigned firstIndex) override;
+};
+
+/// Returns the range of the elements of `value` computed by `solver`, which
+/// must have loaded IntegerRangeAnalysis, or std::nullopt if it is unknown.
+std::optional<ConstantIntRanges> getIntegerRange(DataFlowSolver &solver,
+                                                 Value value);
+
+} // namespace mlir::triton
+
+#endif
@@ -10,6 +10,8 @@ std::unique_ptr<Pass> createCombineOpsPass();
 
 std::unique_ptr<Pass> createReorderBroadcastPass();
 std::unique_ptr<Pass> createRewriteTensorPointerPass();
+std::unique_ptr<Pass> createSpecializeCallSitesPass();
+std::unique_ptr<Pass> createSpecializeCallSitesPass(unsigned sizeBudget);
 
 } // namespace triton
 
@@ -1259,32 +1259,36 @@ unsigned ModuleAxisInfoAnalysis::getMaskAlignment(Value mask) {
   return alignment;
 }
 
-void ModuleAxisInfoAnalysis::initialize(FunctionOpInterface funcOp) {
+AxisInfoMapT computeFuncAxisInfo(FunctionOpInterface funcOp) {
+  AxisInfoMapT axisInfoMap;
   std::unique_ptr<DataFlowSolver> solver = createDataFlowSolver();
   AxisInfoAnalysis *analysis = solver->load<AxisInfoAnalysis>();
   if (failed(solver->initializeAndRun(funcOp)))
-    return;
-  auto *axisInfoMap = getFuncData(funcOp);
-  auto updateAxisInfoMap = [&](Value value) {
-    auto axisInfo = analysis->getLatticeElement(value)->getValue();
-    AxisInfo curAxisInfo;
-    if (axisInfoMap->count(value)) {
-      curAxisInfo = AxisInfo::join(axisInfo, axisInfoMap->lookup(value));
-    } else {
-      curAxisInfo = axisInfo;
-    }
-    (*axisInfoMap)[value] = curAxisInfo;
-  };
+    return axisInfoMap;
   funcOp.walk([&](Operation *op) {
     for (auto value : op->getResults()) {
-      updateAxisInfoMap(value);
+      axisInfoMap[value] = analysis->getLatticeElement(value)->getValue();
     }
   });
   funcOp.walk([&](Block *block) {
     for (auto value : block->getArguments()) {
-      updateAxisInfoMap(value);
+      axisInfoMap[value] = analysis->getLatticeElement(value)->getValue();
     }
   });
+  return axisInfoMap;
+}
+
+void ModuleAxisInfoAnalysis::initialize(FunctionOpInterface funcOp) {
+  auto *axisInfoMap = getFuncData(funcOp);
+  for (auto &[value, axisInfo] : computeFuncAxisInfo(funcOp)) {
+    AxisInfo curAxisInfo;
+    if (axisInfoMap->count(value)) {
+      curAxisInfo = AxisInfo::join(axisInfo, axisInfoMap->lookup(value));
+    } else {
+      curAxisInfo = axisInfo;
+    }
+    (*axisInfoMap)[value] = curAxisInfo;
+  }
 }
 
 void ModuleAxisInfoAnalysis::update(CallOpInterface callOp,
@@ -0,0 +1,192 @@
+#include "mlir/Analysis/DataFlowFramework.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "llvm/ADT/TypeSwitch.h"
+
+#include "triton/Analysis/IntegerRange.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+
+namespace mlir::triton {
+namespace {
+
+// Returns the bit width of the integer elements of `type`, or 0 if they are
+// not integers.
+unsigned getElementBitWidth(Type type) {
+  Type elementType = getElementTypeOrSelf(type);
+  if (elementType.isIndex())
+    return IndexType::kInternalStorageBitWidth;
+  if (auto intType = dyn_cast<IntegerType>(elementType))
+    return intType.getWidth();
+  return 0;
+}
+
+std::optional<ConstantIntRanges> getConstantRange(arith::ConstantOp op) {
+  if (auto intAttr = dyn_cast<IntegerAttr>(op.getValue()))
+    return ConstantIntRanges::constant(intAttr.getValue());
+  auto denseAttr = dyn_cast<DenseIntElementsAttr>(op.getValue());
+  if (!denseAttr)
+    return std::nullopt;
+  if (denseAttr.isSplat())
+    return ConstantIntRanges::constant(denseAttr.getSplatValue<APInt>());
+  std::optional<ConstantIntRanges> range;
+  for (const APInt &value : denseAttr.getValues<APInt>()) {
+    auto valueRange = ConstantIntRanges::constant(value);
+    range = range ? range->rangeUnion(valueRange) : valueRange;
+  }
+  return range;
+}
+
+// Extensions and truncations are handled here rather than through
+// InferIntRangeInterface, so that the width of the result is taken from the
+// element type of tensors.
+std::optional<ConstantIntRanges>
+getCastRange(Operation *op, const ConstantIntRanges &operand) {
+  unsigned width = getElementBitWidth(op->getResult(0).getType());
+  return TypeSwitch<Operation *, std::optional<ConstantIntRanges>>(op)
+      .Case([&](arith::ExtSIOp) {
+        return ConstantIntRanges::fromSigned(operand.smin().sext(width),
+                                             operand.smax().sext(width));
+      })
+      .Case([&](arith::ExtUIOp) {
+        return ConstantIntRanges::fromUnsigned(operand.umin().zext(width),
+                                               operand.umax().zext(width));
+      })
+      .Case([&](arith::TruncIOp) -> std::optional<ConstantIntRanges> {
+        // The range is preserved if its bounds fit in the result type.
+        if (operand.smin().getSignificantBits() > width ||
+            operand.smax().getSignificantBits() > width)
+          return ConstantIntRanges::maxRange(width);
+        return ConstantIntRanges::fromSigned(operand.smin().trunc(width),
+                                             operand.smax().trunc(width));
+      })
+      .Default([](Operation *) { return std::nullopt; });
+}
+
+} // namespace
+
+IntegerRange IntegerRange::getPessimisticValueState(Value value) {
+  unsigned width = getElementBitWidth(value.getType());
+  if (width == 0)
+    return IntegerRange();
+  return IntegerRange(ConstantIntRanges::maxRange(width));
+}
+
+IntegerRange IntegerRange::join(const IntegerRange &lhs,
+                                const IntegerRange &rhs) {
+  if (lhs.isUninitialized())
+    return rhs;
+  if (rhs.isUninitialized())
+    return lhs;
+  return IntegerRange(lhs.getRange().rangeUnion(rhs.getRange()));
+}
+
+void IntegerRangeAnalysis::setToEntryState(
+    dataflow::Lattice<IntegerRange> *lattice) {
+  propagateIfChanged(lattice,
+                     lattice->join(IntegerRange::getPessimisticValueState(
+                         lattice->getPoint())));
+}
+
+void IntegerRangeAnalysis::visitOperation(
+    Operation *op, ArrayRef<const dataflow::Lattice<IntegerRange> *> operands,
+    ArrayRef<dataflow::Lattice<IntegerRange> *> results) {
+  // Wait for the ranges of the integer operands to be known.
+  SmallVector<ConstantIntRanges> operandRanges;
+  for (auto [operand, lattice] : llvm::zip(op->getOperands(), operands)) {
+    if (lattice->getValue().isUninitialized()) {
+      if (getElementBitWidth(operand.getType()) != 0)
+        return;
+      continue;
+    }
+    operandRanges.push_back(lattice->getValue().getRange());
+  }
+  auto join = [&](Value value, const ConstantIntRanges &range) {
+    auto result = dyn_cast<OpResult>(value);
+    if (!result || result.getOwner() != op)
+      return;
+    dataflow::Lattice<IntegerRange> *lattice =
+        results[result.getResultNumber()];
+    propagateIfChanged(lattice, lattice->join(IntegerRange(range)));
+  };
+
+  APInt zero = APInt::getZero(32);
+  APInt int32Max = APInt::getSignedMaxValue(32);
+  std::optional<ConstantIntRanges> range =
+      TypeSwitch<Operation *, std::optional<ConstantIntRanges>>(op)
+          .Case([&](arith::ConstantOp constantOp) {
+            return getConstantRange(constantOp);
+          })
+          .Case([&](MakeRangeOp makeRangeOp) {
+            return ConstantIntRanges::fromSigned(
+                APInt(32, makeRangeOp.getStart()),
+                APInt(32, makeRangeOp.getEnd() - 1));
+          })
+          // Grid dimensions fit in a positive i32.
+          .Case([&](GetProgramIdOp) {
+            return ConstantIntRanges::fromSigned(zero, int32Max - 1);
+          })
+          .Case([&](GetNumProgramsOp) {
+            return ConstantIntRanges::fromSigned(APInt(32, 1), int32Max);
+          })
+          .Case<SplatOp, BroadcastOp, ExpandDimsOp, ReshapeOp, TransOp>(
+              [&](Operation *) -> std::optional<ConstantIntRanges> {
+                if (operandRanges.empty())
+                  return std::nullopt;
+                return operandRanges.front();
+              })
+          .Case<arith::ExtSIOp, arith::ExtUIOp, arith::TruncIOp>(
+              [&](Operation *castOp) {
+                return getCastRange(castOp, operandRanges.front());
+              })
+          .Default([](Operation *) { return std::nullopt; });
+  if (range) {
+    join(op->getResult(0), *range);
+    return;
+  }
+
+  // The other casts may need the width of a tensor element type, which
+  // InferIntRangeInterface does not take into account.
+  auto inferrable = dyn_cast<InferIntRangeInterface>(op);
+  if (!inferrable || isa<CastOpInterface>(op) ||
+      operandRanges.size() != op->getNumOperands())
+    return setAllToEntryStates(results);
+  inferrable.inferResultRanges(operandRanges, join);
+}
+
+void IntegerRangeAnalysis::visitNonControlFlowArguments(
+    Operation *op, const RegionSuccessor &successor,
+    ArrayRef<dataflow::Lattice<IntegerRange> *> argLattices,
+    unsigned firstIndex) {
+  auto forOp = dyn_cast<scf::ForOp>(op);
+  if (!forOp)
+    return SparseForwardDataFlowAnalysis::visitNonControlFlowArguments(
+        op, successor, argLattices, firstIndex);
+
+  // The induction variable ranges over [lb, ub) when the step is positive.
+  const IntegerRange &lb =
+      getLatticeElementFor(op, forOp.getLowerBound())->getValue();
+  const IntegerRange &ub =
+      getLatticeElementFor(op, forOp.getUpperBound())->getValue();
+  const IntegerRange &step =
+      getLatticeElementFor(op, forOp.getStep())->getValue();
+  if (lb.isUninitialized() || ub.isUninitialized() || step.isUninitialized())
+    return;
+  if (!step.getRange().smin().isStrictlyPositive())
+    return setToEntryState(argLattices.front());
+  APInt lower = lb.getRange().smin();
+  APInt upper = ub.getRange().smax();
+  upper = upper.sle(lower) ? lower : upper - 1;
+  propagateIfChanged(argLattices.front(),
+                     argLattices.front()->join(IntegerRange(
+                         ConstantIntRanges::fromSigned(lower, upper))));
+}
+
+std::optional<ConstantIntRanges> getIntegerRange(DataFlowSolver &solver,
+                                                 Value value) {
+  auto *lattice = solver.lookupState<dataflow::Lattice<IntegerRange>>(value);
+  if (!lattice || lattice->getValue().isUninitialized())
+    return std::nullopt;
+  return lattice->getValue().getRange();
+}
+
+} // namespace mlir::triton
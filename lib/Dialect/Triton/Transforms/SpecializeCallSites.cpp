@@ -0,0 +1,171 @@
+#include <iterator>
+#include <map>
+#include <memory>
+#include <numeric>
+
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/SymbolTable.h"
+#include "mlir/Interfaces/CallInterfaces.h"
+#include "mlir/Interfaces/FunctionInterfaces.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Support/LLVM.h"
+#include "triton/Analysis/AxisInfo.h"
+#include "triton/Analysis/Utility.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+#include "triton/Dialect/Triton/Transforms/Passes.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SetVector.h"
+#include "llvm/Support/Debug.h"
+
+#define DEBUG_TYPE "triton-specialize-call-sites"
+#define DBGS() (llvm::dbgs() << "[" DEBUG_TYPE "]: ")
+#define LDBG(X) LLVM_DEBUG(DBGS() << X << "\n")
+
+#define GEN_PASS_DECL_TRITONSPECIALIZECALLSITES
+#define GEN_PASS_DEF_TRITONSPECIALIZECALLSITES
+#include "triton/Dialect/Triton/Transforms/Passes.h.inc"
+
+namespace mlir::triton {
+namespace {
+
+// The contiguity, divisibility and constancy of each operand of a call,
+// flattened.  Operands without axis info (non scalar values or values the
+// analysis could not reach) are described by zeros, which never match the
+// axis info of a real value and are not turned into attributes.
+using CallSignature = SmallVector<int64_t>;
+
+constexpr StringLiteral axisInfoAttrNames[] = {"tt.contiguity",
+                                               "tt.divisibility",
+                                               "tt.constancy"};
+
+CallSignature getCallSignature(CallOpInterface callOp,
+                               const AxisInfoMapT &axisInfoMap) {
+  CallSignature signature;
+  for (Value operand : callOp->getOperands()) {
+    auto it = axisInfoMap.find(operand);
+    if (it == axisInfoMap.end() || it->second.getRank() != 1) {
+      signature.append(std::size(axisInfoAttrNames), 0);
+      continue;
+    }
+    const AxisInfo &axisInfo = it->second;
+    signature.push_back(axisInfo.getContiguity(0));
+    signature.push_back(axisInfo.getDivisibility(0));
+    signature.push_back(axisInfo.getConstancy(0));
+  }
+  return signature;
+}
+
+// Narrows the argument attributes of `funcOp` to the facts described by
+// `signature`.  Like ModuleAxisInfoAnalysis, the facts already attached to the
+// arguments are kept by taking the gcd with them.
+void setArgAttrs(FunctionOpInterface funcOp, const CallSignature &signature) {
+  auto i64Ty = IntegerType::get(funcOp.getContext(), 64);
+  for (unsigned argIdx = 0; argIdx < funcOp.getNumArguments(); ++argIdx) {
+    for (auto [attrIdx, attrName] : llvm::enumerate(axisInfoAttrNames)) {
+      int64_t value =
+          signature[argIdx * std::size(axisInfoAttrNames) + attrIdx];
+      if (value == 0)
+        continue;
+      if (auto attr = funcOp.getArgAttrOfType<IntegerAttr>(argIdx, attrName))
+        value = std::gcd(value, attr.getInt());
+      funcOp.setArgAttr(argIdx, attrName, IntegerAttr::get(i64Ty, value));
+    }
+  }
+}
+
+class SpecializeCallSitesPass
+    : public ::impl::TritonSpecializeCallSitesBase<SpecializeCallSitesPass> {
+public:
+  using ::impl::TritonSpecializeCallSitesBase<
+      SpecializeCallSitesPass>::TritonSpecializeCallSitesBase;
+
+  void runOnOperation() override {
+    ModuleOp mod = getOperation();
+    SymbolTable symbolTable(mod);
+
+    // Order the functions so that every caller comes before its callees.
+    SmallVector<FunctionOpInterface> funcs;
+    CallGraph<char> callGraph(mod);
+    callGraph.walk<WalkOrder::PreOrder, WalkOrder::PostOrder>(
+        [](CallOpInterface callOp, FunctionOpInterface funcOp) {},
+        [&](FunctionOpInterface funcOp) { funcs.push_back(funcOp); });
+    SetVector<FunctionOpInterface> sortedFuncs(funcs.begin(), funcs.end());
+
+    // The call sites of each callee, grouped by signature in program order.
+    using CallSiteGroups =
+        llvm::MapVector<CallSignature, SmallVector<CallOpInterface>,
+                        std::map<CallSignature, unsigned>>;
+    DenseMap<FunctionOpInterface, CallSiteGroups> callSites;
+
+    int64_t budget = sizeBudget;
+    for (FunctionOpInterface funcOp : llvm::reverse(sortedFuncs)) {
+      SmallVector<FunctionOpInterface> specializations{funcOp};
+      // The first group of call sites, and those not fitting in the budget,
+      // keep calling the original function.
+      SmallVector<const CallSignature *> remaining;
+      auto it = callSites.find(funcOp);
+      if (it != callSites.end()) {
+        int64_t size = 0;
+        funcOp.walk([&](Operation *op) { ++size; });
+        for (auto &[signature, calls] : it->second) {
+          if (remaining.empty() || size > budget) {
+            remaining.push_back(&signature);
+            continue;
+          }
+          budget -= size;
+          auto clone = cast<FunctionOpInterface>(funcOp->clone());
+          SymbolTable::setSymbolVisibility(clone,
+                                           SymbolTable::Visibility::Private);
+          symbolTable.insert(clone, std::next(funcOp->getIterator()));
+          setArgAttrs(clone, signature);
+          auto calleeAttr = FlatSymbolRefAttr::get(clone);
+          for (CallOpInterface callOp : calls)
+            callOp.setCalleeFromCallable(calleeAttr);
+          LDBG("cloned " << funcOp.getName() << " into " << clone.getName());
+          specializations.push_back(clone);
+        }
+        if (remaining.size() > 1)
+          LDBG("budget exhausted, " << remaining.size()
+                                    << " call site signatures left on "
+                                    << funcOp.getName());
+      }
+      // When every remaining call site agrees, the original function can be
+      // specialized in place; otherwise ModuleAxisInfoAnalysis merges them.
+      if (remaining.size() == 1)
+        setArgAttrs(funcOp, *remaining.front());
+
+      // Record the call sites of the function and of its clones, now that
+      // their argument attributes are final.
+      for (FunctionOpInterface specialization : specializations) {
+        AxisInfoMapT axisInfoMap = computeFuncAxisInfo(specialization);
+        specialization.walk([&](CallOpInterface callOp) {
+          auto calleeAttr =
+              dyn_cast<SymbolRefAttr>(callOp.getCallableForCallee());
+          if (!calleeAttr)
+            return;
+          // Looked up in `symbolTable`, which knows about the clones.
+          auto callee = symbolTable.lookup<FunctionOpInterface>(
+              calleeAttr.getRootReference());
+          if (!callee)
+            return;
+          callSites[callee][getCallSignature(callOp, axisInfoMap)].push_back(
+              callOp);
+        });
+      }
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<Pass> createSpecializeCallSitesPass() {
+  return std::make_unique<SpecializeCallSitesPass>();
+}
+
+std::unique_ptr<Pass> createSpecializeCallSitesPass(unsigned sizeBudget) {
+  ::TritonSpecializeCallSitesOptions options;
+  options.sizeBudget = sizeBudget;
+  return std::make_unique<SpecializeCallSitesPass>(options);
+}
+
+} // namespace mlir::triton
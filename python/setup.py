@@ -540,7 +540,7 @@ class plugin_egginfo(egg_info):
 
 
 package_data = {
-    "triton/tools": ["compile.h", "compile.c"],
+    "triton/tools": ["compile.h", "compile.c", "compile_xpu.h", "compile_xpu.cpp"],
     **{f"triton/backends/{b.name}": b.package_data
        for b in backends},
 }
@@ -568,9 +568,14 @@ def get_packages():
 
 
 def get_entry_points():
-    entry_points = {}
+    entry_points = {
+        "console_scripts": [
+            "triton-cache = triton.tools.cache:main",
+            "triton-compile-server = triton.compiler.compile_server:main",
+        ]
+    }
     if check_env_flag("TRITON_BUILD_PROTON", "ON"):  # Default ON
-        entry_points["console_scripts"] = [
+        entry_points["console_scripts"] += [
             "proton-viewer = triton.profiler.viewer:main",
             "proton = triton.profiler.proton:main",
         ]
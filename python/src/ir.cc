@@ -27,6 +27,8 @@
 #include "triton/Dialect/Triton/IR/Types.h"
 #include "triton/Dialect/Triton/IR/Utility.h"
 #include "triton/Tools/Sys/GetEnv.hpp"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/ThreadPool.h"
 
 namespace {
 
@@ -132,6 +134,63 @@ void outputWarning(Location loc, const std::string &msg) {
                /*stack_level=*/2);
 }
 
+// A context reused across compilations. All the pooled contexts share a
+// single thread pool instead of each starting its own threads, and `reset`
+// restores the settings a compilation may have changed.
+class PooledContext : public MLIRContext {
+public:
+  PooledContext() : MLIRContext(Threading::DISABLED) {
+    setThreadPool(getSharedThreadPool());
+    printOpOnDiagnosticByDefault = shouldPrintOpOnDiagnostic();
+    printStackTraceOnDiagnosticByDefault = shouldPrintStackTraceOnDiagnostic();
+    getPooledContexts().insert(this);
+  }
+
+  ~PooledContext() { getPooledContexts().erase(this); }
+
+  static PooledContext *lookup(MLIRContext *context) {
+    if (!getPooledContexts().contains(context))
+      return nullptr;
+    return static_cast<PooledContext *>(context);
+  }
+
+  // Replaces the diagnostic handler of the previous compilation rather than
+  // stacking a new one on top of it.
+  void setDebugHandler(DiagnosticEngine::HandlerID handler) {
+    if (debugHandler)
+      getDiagEngine().eraseHandler(*debugHandler);
+    debugHandler = handler;
+  }
+
+  void reset() {
+    if (debugHandler)
+      getDiagEngine().eraseHandler(*debugHandler);
+    debugHandler.reset();
+    printOpOnDiagnostic(printOpOnDiagnosticByDefault);
+    printStackTraceOnDiagnostic(printStackTraceOnDiagnosticByDefault);
+    disableMultithreading(false);
+  }
+
+  bool hasDebugHandler() const { return debugHandler.has_value(); }
+
+private:
+  // Both are intentionally leaked: the Python objects owning the pooled
+  // contexts may be destroyed after the static destructors have run.
+  static llvm::ThreadPoolInterface &getSharedThreadPool() {
+    static auto *threadPool = new llvm::DefaultThreadPool();
+    return *threadPool;
+  }
+
+  static llvm::DenseSet<MLIRContext *> &getPooledContexts() {
+    static auto *pooledContexts = new llvm::DenseSet<MLIRContext *>();
+    return *pooledContexts;
+  }
+
+  bool printOpOnDiagnosticByDefault = true;
+  bool printStackTraceOnDiagnosticByDefault = false;
+  std::optional<DiagnosticEngine::HandlerID> debugHandler;
+};
+
 } // anonymous namespace
 
 /*****************************************************************************/
@@ -214,6 +273,14 @@ void init_triton_ir(py::module &&m) {
 
   py::class_<MLIRContext>(m, "context", py::module_local()).def(py::init<>());
 
+  py::class_<PooledContext, MLIRContext>(m, "pooled_context",
+                                         py::module_local())
+      .def(py::init<>())
+      .def("reset", &PooledContext::reset)
+      .def("has_debug_handler", &PooledContext::hasDebugHandler)
+      .def("is_multithreading_enabled",
+           &PooledContext::isMultithreadingEnabled);
+
   m.def("load_dialects", [](MLIRContext &context) {
     DialectRegistry registry;
     registry.insert<TritonDialect, ::mlir::triton::gpu::TritonGPUDialect,
@@ -462,6 +529,17 @@ void init_triton_ir(py::module &&m) {
              self.print(os, printingFlags);
              return str;
            })
+      .def(
+          "bytecode",
+          [](ModuleOp &self, const std::string &producer) -> py::bytes {
+            std::string str;
+            llvm::raw_string_ostream os(str);
+            BytecodeWriterConfig config(producer);
+            if (failed(writeBytecodeToFile(self, os, config)))
+              throw std::runtime_error("Failed to write MLIR bytecode.");
+            return py::bytes(os.str());
+          },
+          py::arg("producer") = "Triton")
       .def("push_back",
            [](ModuleOp &self, FuncOp &funcOp) -> void {
              self.push_back(funcOp);
@@ -1581,10 +1659,13 @@ void init_triton_ir(py::module &&m) {
                context->printOpOnDiagnostic(true);
                context->printStackTraceOnDiagnostic(true);
              }
-             context->getDiagEngine().registerHandler([](Diagnostic &diag) {
-               llvm::outs() << diag << "\n";
-               return success();
-             });
+             auto handler = context->getDiagEngine().registerHandler(
+                 [](Diagnostic &diag) {
+                   llvm::outs() << diag << "\n";
+                   return success();
+                 });
+             if (auto *pooledContext = PooledContext::lookup(context))
+               pooledContext->setDebugHandler(handler);
              if (haveDump) {
                auto printingFlags = OpPrintingFlags();
                printingFlags.elideLargeElementsAttrs(16);
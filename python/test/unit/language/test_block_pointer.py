@@ -4,7 +4,7 @@ import intel_extension_for_pytorch  # type: ignore # noqa: F401
 
 import triton
 import triton.language as tl
-from test_core import check_type_supported
+from test_core import check_type_supported, is_xpu
 
 
 def is_cuda():
@@ -107,3 +107,62 @@ def test_block_ptr_matmul_no_scf(shape, num_warps, device):
         num_warps=num_warps)
     golden = torch.matmul(a, b)
     torch.testing.assert_close(c, golden, check_dtype=False)
+
+
+@triton.jit
+def matmul_with_advance_kernel(  #
+        a_ptr, b_ptr, c_ptr,  #
+        M, N, K,  #
+        stride_am, stride_ak,  #
+        stride_bk, stride_bn,  #
+        stride_cm, stride_cn,  #
+        BLOCK_M: tl.constexpr, BLOCK_N: tl.constexpr, BLOCK_K: tl.constexpr  #
+):
+    pid = tl.program_id(0)
+    num_pid_n = tl.cdiv(N, BLOCK_N)
+    pid_m = pid // num_pid_n
+    pid_n = pid % num_pid_n
+    a_block_ptr = tl.make_block_ptr(base=a_ptr, shape=(M, K), strides=(stride_am, stride_ak),
+                                    offsets=(pid_m * BLOCK_M, 0), block_shape=(BLOCK_M, BLOCK_K), order=(1, 0))
+    b_block_ptr = tl.make_block_ptr(base=b_ptr, shape=(K, N), strides=(stride_bk, stride_bn),
+                                    offsets=(0, pid_n * BLOCK_N), block_shape=(BLOCK_K, BLOCK_N), order=(1, 0))
+    accumulator = tl.zeros((BLOCK_M, BLOCK_N), dtype=tl.float32)
+    for _ in range(0, K, BLOCK_K):
+        a = tl.load(a_block_ptr, boundary_check=(0, 1))
+        b = tl.load(b_block_ptr, boundary_check=(0, 1))
+        accumulator += tl.dot(a, b)
+        a_block_ptr = tl.advance(a_block_ptr, (0, BLOCK_K))
+        b_block_ptr = tl.advance(b_block_ptr, (BLOCK_K, 0))
+    c_block_ptr = tl.make_block_ptr(base=c_ptr, shape=(M, N), strides=(stride_cm, stride_cn),
+                                    offsets=(pid_m * BLOCK_M, pid_n * BLOCK_N), block_shape=(BLOCK_M, BLOCK_N),
+                                    order=(1, 0))
+    tl.store(c_block_ptr, accumulator, boundary_check=(0, 1))
+
+
+@pytest.mark.parametrize("shape", [
+    # skewed shapes, the last wave of tiles is split along K across the programs
+    [512, 4096, 8192],
+    [1000, 3000, 2048],
+])
+def test_block_ptr_matmul_stream_k(shape, device):
+    if not is_xpu():
+        pytest.skip("Stream-K is only supported on XPU")
+    m, n, k = shape
+    a = torch.randn((m, k), device=device, dtype=torch.float16)
+    b = torch.randn((k, n), device=device, dtype=torch.float16)
+    # The partial tiles are accumulated with atomic additions, the output must start from zero.
+    c = torch.zeros((m, n), device=device, dtype=torch.float32)
+
+    BLOCK_M, BLOCK_N, BLOCK_K = 128, 128, 32
+    grid = (triton.cdiv(m, BLOCK_M) * triton.cdiv(n, BLOCK_N), )
+    kernel = matmul_with_advance_kernel[grid](
+        a_ptr=a, b_ptr=b, c_ptr=c,  #
+        M=m, N=n, K=k,  #
+        stride_am=a.stride(0), stride_ak=a.stride(1),  #
+        stride_bk=b.stride(0), stride_bn=b.stride(1),  #
+        stride_cm=c.stride(0), stride_cn=c.stride(1),  #
+        BLOCK_M=BLOCK_M, BLOCK_N=BLOCK_N, BLOCK_K=BLOCK_K,  #
+        num_warps=32, threads_per_warp=16, stream_k=True)
+    assert kernel.metadata.stream_k
+    golden = torch.matmul(a.float(), b.float())
+    torch.testing.assert_close(c, golden, atol=1e-2, rtol=1e-3)
@@ -384,3 +384,26 @@ def test_typeconvert_downcast(src_dtype, dst_dtype, rounding, max_repr, device):
 
     for i in range(256):
         downcast_test(getattr(tl, src_dtype), getattr(tl, dst_dtype), rounding, *stuff, max_repr, i, device=device)
+
+
+@pytest.mark.parametrize("dst_dtype", ['float16', 'float32'])
+def test_typeconvert_fp8e4b15_roundtrip(dst_dtype, device):
+
+    if is_hip():
+        pytest.skip("float8e4b15 upcast tests not supported on ROCm")
+
+    # Every encoding, including the largest exponent (0x78 to 0x7e are finite) and the NaNs (0x7f and 0xff).
+    src = torch.arange(256, dtype=torch.int32, device=device).to(torch.uint8).view(torch.int8)
+
+    dst = launch_type_convert_triton(src, tl.float8e4b15, getattr(tl, dst_dtype), device=device, BLOCK_SIZE=256)
+    dst_to_float32 = launch_type_convert_triton(dst, getattr(tl, dst_dtype), tl.float32, device=device, BLOCK_SIZE=256)
+    dst_to_float32 = dst_to_float32.view(torch.float32).cpu()
+
+    src_emulated_to_float32 = launch_upcast_emulated(src, 4, 3, 15, device=device, BLOCK_SIZE=256).view(torch.float32).cpu()
+    nan = (src.cpu() & 0x7f) == 0x7f
+    assert torch.all(dst_to_float32[nan].isnan())
+    assert torch.equal(dst_to_float32[~nan], src_emulated_to_float32[~nan])
+
+    # The finite values convert back to their original encoding.
+    src2 = launch_type_convert_triton(dst, getattr(tl, dst_dtype), tl.float8e4b15, device=device, rounding='rtz', BLOCK_SIZE=256)
+    assert torch.equal(src2.cpu()[~nan], src.cpu()[~nan])
@@ -5305,6 +5305,38 @@ def test_enable_fp_fusion(enable_fp_fusion, device):
     assert found_fma == enable_fp_fusion
 
 
+# -----------------------
+# test opt_level
+# -----------------------
+
+
+@pytest.mark.parametrize("opt_level", [1, 2])
+@pytest.mark.parametrize("full_pipeline", ["0", "1"])
+def test_opt_level(opt_level, full_pipeline, device, monkeypatch):
+    if not is_xpu():
+        pytest.skip("opt_level is an option of the XPU backend")
+    monkeypatch.setenv("TRITON_INTEL_FULL_TTGIR_PIPELINE", full_pipeline)
+
+    # a dot in a loop, which the pipelining and prefetching passes apply to
+    @triton.jit
+    def matmul(A, B, C, K: tl.constexpr, BLOCK: tl.constexpr):
+        offs = tl.arange(0, BLOCK)
+        acc = tl.zeros((BLOCK, BLOCK), dtype=tl.float32)
+        for k in range(0, K, BLOCK):
+            a = tl.load(A + offs[:, None] * K + (k + offs[None, :]))
+            b = tl.load(B + (k + offs[:, None]) * BLOCK + offs[None, :])
+            acc += tl.dot(a, b)
+        tl.store(C + offs[:, None] * BLOCK + offs[None, :], acc)
+
+    K, BLOCK = 128, 32
+    a = torch.randn((BLOCK, K), device=device, dtype=torch.float16)
+    b = torch.randn((K, BLOCK), device=device, dtype=torch.float16)
+    c = torch.empty((BLOCK, BLOCK), device=device, dtype=torch.float32)
+    h = matmul[(1, )](a, b, c, K=K, BLOCK=BLOCK, opt_level=opt_level)
+    assert h.metadata.opt_level == opt_level
+    torch.testing.assert_close(c, torch.matmul(a.float(), b.float()), atol=1e-2, rtol=1e-2)
+
+
 # -----------------------
 # test propagate_nan
 # -----------------------
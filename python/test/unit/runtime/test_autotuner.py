@@ -131,3 +131,83 @@ def test_prune_configs(with_perf_model: bool):
         assert records['run_early_config_prune']
         assert records['capture_kwargs']
         assert records['capture_named_args']
+
+
+def test_threads_per_warp():
+    N = 1024
+    src = torch.randn(N, device='xpu')
+    dst = torch.empty(N, device='xpu')
+
+    configs = [
+        triton.Config(kwargs={'BLOCK_SIZE': 128}, threads_per_warp=16),
+        triton.Config(kwargs={'BLOCK_SIZE': 128}, threads_per_warp=32)
+    ]
+
+    @triton.autotune(configs=configs, key=['N'], warmup=1, rep=1)
+    @triton.jit
+    def _kernel(dst, src, N, BLOCK_SIZE: tl.constexpr):
+        offsets = tl.program_id(0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+        x = tl.load(src + offsets, mask=offsets < N)
+        tl.store(dst + offsets, x, mask=offsets < N)
+
+    grid = lambda META: (triton.cdiv(N, META['BLOCK_SIZE']), )
+    _kernel[grid](dst, src, N)
+    torch.testing.assert_close(src, dst)
+    assert _kernel.best_config.threads_per_warp in (16, 32)
+
+    # Without an explicit value, the number of threads per warp is chosen from the content of the kernel.
+    @triton.jit
+    def _copy(dst, src, N, BLOCK_SIZE: tl.constexpr):
+        offsets = tl.program_id(0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+        x = tl.load(src + offsets, mask=offsets < N)
+        tl.store(dst + offsets, x, mask=offsets < N)
+
+    @triton.jit
+    def _row_sum(dst, src, BLOCK_SIZE: tl.constexpr):
+        offsets = tl.program_id(0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+        x = tl.load(src + offsets)
+        tl.store(dst + tl.program_id(0), tl.sum(x, axis=0))
+
+    # The spill size of the kernel built with the chosen number of threads per warp is reported once it is loaded.
+    copy_metadata = _copy[(N // 128, )](dst, src, N, BLOCK_SIZE=128).metadata
+    assert copy_metadata.threads_per_warp == 32
+    assert copy_metadata.n_spills == 0
+    row_sums = torch.empty(N // 8, device='xpu')
+    row_sum_metadata = _row_sum[(N // 8, )](row_sums, src, BLOCK_SIZE=8).metadata
+    assert row_sum_metadata.threads_per_warp == 16
+    assert row_sum_metadata.n_spills == 0
+    torch.testing.assert_close(row_sums, src.reshape(-1, 8).sum(axis=1))
+
+
+def test_prune_spilling_configs():
+    N = 1024
+    src = torch.randn(N, device='xpu')
+    dst = torch.empty(N, device='xpu')
+
+    configs = [triton.Config(kwargs={'BLOCK_SIZE': 32}), triton.Config(kwargs={'BLOCK_SIZE': 128})]
+
+    @triton.autotune(configs=configs, key=['N'], prune_configs_by={'max_spills': 0}, warmup=1, rep=1)
+    @triton.jit
+    def _kernel(dst, src, N, BLOCK_SIZE: tl.constexpr):
+        offsets = tl.program_id(0) * BLOCK_SIZE + tl.arange(0, BLOCK_SIZE)
+        x = tl.load(src + offsets, mask=offsets < N)
+        tl.store(dst + offsets, x, mask=offsets < N)
+
+    grid = lambda META: (triton.cdiv(N, META['BLOCK_SIZE']), )
+    _kernel[grid](dst, src, N)
+    torch.testing.assert_close(src, dst)
+    # A copy kernel does not spill, no config is pruned.
+    assert len(_kernel.configs_timings) == 2
+
+    kernel = _kernel.fn.warmup(dst, src, N, BLOCK_SIZE=32, grid=(1, ))
+    device = triton.runtime.driver.active.get_current_device()
+    resources = triton.runtime.driver.active.utils.get_kernel_resources(kernel.name, kernel.kernel, device)
+    triton.runtime.driver.active.utils.release_kernel_resources(kernel.kernel, device)
+    assert resources["n_spills"] == 0
+    assert resources["private_mem_size"] == 0
+    assert resources["local_mem_size"] >= 0
+    # Loading the kernel adds its resources to the metadata.
+    _kernel.fn.run(dst, src, N, BLOCK_SIZE=32, grid=(N // 32, ), warmup=False)
+    assert kernel.metadata.n_spills == 0
+    assert kernel.metadata.private_mem_size == 0
+    assert kernel.metadata.local_mem_size >= 0
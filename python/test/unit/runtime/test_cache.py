@@ -1,3 +1,4 @@
+import gc
 import importlib.util
 import itertools
 import os
@@ -10,7 +11,7 @@ import intel_extension_for_pytorch  # type: ignore # noqa: F401
 
 import triton
 import triton.language as tl
-from triton.runtime.jit import JITFunction
+from triton.runtime.jit import JITFunction, parse_alignment_tiers
 
 tmpdir = ".tmp"
 
@@ -173,6 +174,238 @@ def test_reuse():
     assert counter == 1
 
 
+def test_ir_bytecode(monkeypatch):
+
+    @triton.jit
+    def kernel(X, i, BLOCK: tl.constexpr):
+        tl.store(X + tl.arange(0, BLOCK), i)
+
+    monkeypatch.setenv("TRITON_STORE_IR_BYTECODE", "1")
+    reset_tmp_dir()
+    x = torch.empty(1024, dtype=torch.int32, device='xpu')
+    compiled = kernel[(1, )](x, 1, BLOCK=1024)
+    cached_ttir = next(p for p in os.listdir(os.path.join(tmpdir, compiled.hash)) if p.endswith(".ttir"))
+    with open(os.path.join(tmpdir, compiled.hash, cached_ttir), "rb") as f:
+        assert f.read(4) == b"ML\xefR"
+    assert "tt.func public @kernel" in compiled.asm["ttir"]
+    assert "triton_gpu.num-warps" in compiled.asm["ttgir"]
+
+
+def test_asm_removed_from_cache():
+
+    @triton.jit
+    def kernel(X, i, BLOCK: tl.constexpr):
+        tl.store(X + tl.arange(0, BLOCK), i)
+
+    reset_tmp_dir()
+    x = torch.empty(1024, dtype=torch.int32, device='xpu')
+    compiled = kernel[(1, )](x, 1, BLOCK=1024)
+    shutil.rmtree(os.path.join(tmpdir, compiled.hash))
+    # the binary is read when loading the kernel
+    kernel[(1, )](x, 1, BLOCK=1024)
+    with pytest.raises(RuntimeError, match="removed from the cache directory"):
+        compiled.asm["ttir"]
+
+
+def test_compile_lock_waits_for_owner():
+    import threading
+    import time
+    from triton.runtime.cache import FileCacheManager
+
+    reset_tmp_dir()
+    manager = FileCacheManager("compile_lock")
+    events = []
+
+    def compile_kernel(name, duration):
+        with manager.compile_lock("kernel.json"):
+            events.append(f"{name} start")
+            time.sleep(duration)
+            events.append(f"{name} end")
+
+    owner = threading.Thread(target=compile_kernel, args=("owner", 0.5))
+    owner.start()
+    while not os.path.exists(os.path.join(manager.cache_dir, "kernel.json.lock")):
+        time.sleep(0.01)
+    compile_kernel("waiter", 0)
+    owner.join()
+    assert events == ["owner start", "owner end", "waiter start", "waiter end"]
+    assert not os.path.exists(os.path.join(manager.cache_dir, "kernel.json.lock"))
+
+
+def test_compile_lock_stale(monkeypatch):
+    import socket
+    import subprocess
+    import sys
+    from triton.runtime.cache import FileCacheManager
+
+    reset_tmp_dir()
+    manager = FileCacheManager("compile_lock_stale")
+    lock_path = os.path.join(manager.cache_dir, "kernel.json.lock")
+    # lock left behind by a compiler that crashed
+    dead = subprocess.Popen([sys.executable, "-c", "pass"])
+    dead.wait()
+    with open(lock_path, "w") as f:
+        f.write(f"{socket.gethostname()} {dead.pid} token")
+    with manager.compile_lock("kernel.json"):
+        pass
+    # lock held for longer than the timeout by a process of another host
+    with open(lock_path, "w") as f:
+        f.write("other-host 1 token")
+    monkeypatch.setenv("TRITON_COMPILE_LOCK_TIMEOUT", "0.1")
+    with manager.compile_lock("kernel.json"):
+        pass
+
+
+def test_compile_lock_keeps_lock_of_other_owner():
+    from triton.runtime.cache import FileCacheManager
+
+    reset_tmp_dir()
+    manager = FileCacheManager("compile_lock_owner")
+    lock_path = os.path.join(manager.cache_dir, "kernel.json.lock")
+    with manager.compile_lock("kernel.json"):
+        # the lock was broken as stale and taken by another process
+        with open(lock_path, "w") as f:
+            f.write("other-host 1 token")
+    assert os.path.exists(lock_path)
+
+
+def test_cache_index_lru_eviction(monkeypatch):
+    from triton.runtime import cache
+    from triton.runtime.cache import CacheIndex, FileCacheManager
+
+    reset_tmp_dir()
+    monkeypatch.setenv("TRITON_CACHE_MAX_SIZE", "2500")
+    for key in ["a", "b", "c"]:
+        # the kernels are cached by different processes, which don't evict the kernels they opened
+        monkeypatch.setattr(cache, "_cache_indexes", {})
+        manager = FileCacheManager(key)
+        path = manager.put(b"x" * 1000, "kernel.bin")
+        manager.put_group("kernel.json", {"kernel.bin": path})
+        if key == "b":
+            # use "a" again, making "b" the least recently used
+            manager = FileCacheManager("a")
+            assert manager.get_group("kernel.json")
+            manager.index.flush()
+    assert sorted(os.listdir(tmpdir)) == ["a", "c", CacheIndex.filename]
+    assert CacheIndex(tmpdir).stats()["entries"] == 2
+
+
+def test_cache_index_keeps_opened_kernels(monkeypatch):
+    from triton.runtime import cache
+    from triton.runtime.cache import CacheIndex, FileCacheManager
+
+    reset_tmp_dir()
+    monkeypatch.setattr(cache, "_cache_indexes", {})
+    monkeypatch.setenv("TRITON_CACHE_INDEX", "1")
+    for key in ["a", "b"]:
+        manager = FileCacheManager(key)
+        path = manager.put(b"x" * 1000, "kernel.bin")
+        manager.put_group("kernel.json", {"kernel.bin": path})
+    # the accesses are only written when flushed
+    index = manager.index
+    newest_access = index.stats()["newest_access"]
+    assert FileCacheManager("a").get_group("kernel.json")
+    assert index.stats()["newest_access"] == newest_access
+    index.flush()
+    assert index.stats()["newest_access"] > newest_access
+
+    class Kernel:
+        pass
+
+    # the kernels still alive in the process are not evicted by it
+    kernel = Kernel()
+    index.keep_alive("a", kernel)
+    assert index.evict(max_size=0, dry_run=True) == ["b"]
+    assert CacheIndex(tmpdir).evict(max_size=0, dry_run=True) == ["b", "a"]
+    # once they are released, their files can be evicted
+    del kernel
+    gc.collect()
+    assert index.evict(max_size=0) == ["b", "a"]
+
+
+def test_context_pool_reset(monkeypatch):
+    from triton.compiler import compiler
+
+    @triton.jit
+    def kernel(X):
+        tl.store(X, 1)
+
+    monkeypatch.setenv("TRITON_CONTEXT_POOL", "1")
+    monkeypatch.setenv("TRITON_ALWAYS_COMPILE", "1")
+    acquired = []
+    acquire = compiler.context_pool.acquire
+
+    def acquire_and_record(backend):
+        context = acquire(backend)
+        acquired.append((context, context.is_multithreading_enabled(), context.has_debug_handler()))
+        return context
+
+    monkeypatch.setattr(compiler.context_pool, "acquire", acquire_and_record)
+    device = torch.xpu.current_device()
+    x = torch.empty(1, dtype=torch.int32, device='xpu')
+    with monkeypatch.context() as m:
+        m.setenv("MLIR_ENABLE_DUMP", "1")
+        kernel[(1, )](x)
+    kernel.cache[device].clear()
+    kernel[(1, )](x)
+    assert x.item() == 1
+    # the next compilation reuses the context without the debug handler and
+    # the single-threading of the dump
+    (first, multithreading, _), (second, reused_multithreading, reused_debug_handler) = acquired
+    assert second is first
+    assert reused_multithreading == multithreading
+    assert not reused_debug_handler
+
+
+def test_compile_server(monkeypatch):
+    import subprocess
+    import sys
+    import time
+    from triton.compiler import compiler
+
+    reset_tmp_dir()
+    kernel.cache.clear()
+    # the in-process compilations acquire a pooled context
+    monkeypatch.setenv("TRITON_CONTEXT_POOL", "1")
+    address = os.path.join(tempfile.mkdtemp(), "compile-server.sock")
+    server = subprocess.Popen(
+        [sys.executable, "-m", "triton.compiler.compile_server", "--socket", address, "--workers", "1"])
+    try:
+        while not os.path.exists(address):
+            assert server.poll() is None
+            time.sleep(0.1)
+        monkeypatch.setenv("TRITON_COMPILE_SERVER", address)
+
+        def compile_in_process(*args, **kwargs):
+            raise AssertionError("the kernel should be compiled by the server")
+
+        with monkeypatch.context() as m:
+            m.setattr(compiler.context_pool, "acquire", compile_in_process)
+            x = torch.empty(1, dtype=torch.int32, device='xpu')
+            kernel[(1, )](x, 1, BLOCK=1024)
+            assert x.item() == 4
+
+        # kernels defined in a function can't be imported by the server
+        @triton.jit
+        def local_kernel(X):
+            tl.store(X, 1)
+
+        local_kernel[(1, )](x)
+        assert x.item() == 1
+    finally:
+        server.terminate()
+        server.wait()
+
+
+def test_compile_server_fallback(monkeypatch):
+    reset_tmp_dir()
+    kernel.cache.clear()
+    monkeypatch.setenv("TRITON_COMPILE_SERVER", os.path.join(tempfile.mkdtemp(), "missing.sock"))
+    x = torch.empty(1, dtype=torch.int32, device='xpu')
+    kernel[(1, )](x, 1, BLOCK=1024)
+    assert x.item() == 4
+
+
 @pytest.mark.parametrize('mode', ['enable', 'disable'])
 def test_specialize(mode):
     counter = 0
@@ -185,7 +418,7 @@ def test_specialize(mode):
     reset_tmp_dir()
     x = torch.empty(1, dtype=torch.int32, device='xpu')
     function = {'enable': kernel, 'disable': kernel_nospec}[mode]
-    target = {'enable': 3, 'disable': 1}[mode]
+    target = {'enable': 4, 'disable': 1}[mode]
     for i in [1, 2, 4, 8, 16, 32]:
         function[(1, )](x, i, BLOCK=512)
     assert counter == target
@@ -207,6 +440,48 @@ def test_annotation():
     assert len(kernel.cache[device]) == 3
 
 
+def test_alignment_tiers(monkeypatch):
+
+    @triton.jit
+    def kernel(X, i):
+        tl.store(X, i)
+
+    x = torch.empty(1, dtype=torch.int32, device='xpu')
+
+    device = torch.xpu.current_device()
+    # with the default tiers, only the divisibility by 16 is specialized on
+    monkeypatch.setattr(JITFunction, "alignment_tiers", parse_alignment_tiers("16"))
+    for i in [16, 32, 64, 128, 256]:
+        kernel[(1, )](x, i)
+    assert len(kernel.cache[device]) == 1
+
+    monkeypatch.setattr(JITFunction, "alignment_tiers", parse_alignment_tiers("16,32,64,128"))
+    kernel.cache[device].clear()
+    for i in [16, 32, 64, 128, 256]:
+        kernel[(1, )](x, i)
+    assert len(kernel.cache[device]) == 4
+    ttirs = [k.asm["ttir"] for k in kernel.cache[device].values()]
+    assert any("%arg1: i32 {tt.divisibility = 64 : i32}" in ttir for ttir in ttirs)
+
+
+def test_max_aligned_specializations(monkeypatch):
+
+    @triton.jit
+    def kernel(X, i):
+        tl.store(X, i)
+
+    monkeypatch.setattr(JITFunction, "alignment_tiers", parse_alignment_tiers("16,32,64,128"))
+    monkeypatch.setattr(JITFunction, "max_aligned_specializations", 1)
+    x = torch.empty(1, dtype=torch.int32, device='xpu')
+
+    device = torch.xpu.current_device()
+    for i in [32, 64, 128, 16]:
+        kernel[(1, )](x, i)
+    # once a kernel is specialized on an alignment tier, the other alignments
+    # fall back to the divisibility by 16
+    assert len(kernel.cache[device]) == 2
+
+
 GLOBAL_DEFAULT_ARG = 1
 
 
@@ -1,10 +1,13 @@
 import glob
+import json
 import os
+import shutil
 import subprocess
 import sys
 import tempfile
 
 import numpy as np
+import pytest
 
 import triton
 from triton.backends.compiler import GPUTarget
@@ -195,7 +198,7 @@ def write_triton_kernels(dir, src, util_src):
     return kernel_path
 
 
-def _compile_kernel(dir, signature, kernel_name, out_name, out_path, num_warps, grid, kernel_path):
+def _compile_kernel(dir, signature, kernel_name, out_name, out_path, num_warps, grid, kernel_path, extra_args=()):
     compiler_path = os.path.join(triton.tools.__path__[0], "compile.py")
 
     subprocess.run(
@@ -214,6 +217,7 @@ def _compile_kernel(dir, signature, kernel_name, out_name, out_path, num_warps,
             str(num_warps),
             "-g",
             grid,
+            *extra_args,
             kernel_path,
         ],
         check=True,
@@ -239,7 +243,7 @@ def compile_aot_kernel_no_specialization(dir, kernel_path, dtype, BM, BN, BK):
     )
 
 
-def compile_aot_kernels(dir, kernel_path, dtype, BM, BN, BK, ha_hb_hints):
+def compile_aot_kernels(dir, kernel_path, dtype, BM, BN, BK, ha_hb_hints, extra_args=()):
     # compile all desired configs
     for ha in ha_hb_hints:
         for hb in ha_hb_hints:
@@ -255,6 +259,7 @@ def compile_aot_kernels(dir, kernel_path, dtype, BM, BN, BK, ha_hb_hints):
                 num_warps=1,
                 grid=grid,
                 kernel_path=kernel_path,
+                extra_args=extra_args,
             )
 
 
@@ -424,6 +429,59 @@ def test_compile_link_autotune_matmul():
             np.testing.assert_allclose(c_tri, c_ref * c_ref, atol=1e-4, rtol=1e-4)
 
 
+# Properties of a PVC device, as returned by torch.xpu.get_device_capability, so that no device is needed.
+xpu_device_props = {
+    "name": "Intel(R) Data Center GPU Max 1100",
+    "driver_version": "1.3.29138",
+    "gpu_eu_count": 448,
+    "gpu_subslice_count": 56,
+    "max_work_group_size": 1024,
+    "max_num_sub_groups": 64,
+    "sub_group_sizes": [16, 32],
+    "has_fp64": True,
+    "device_arch": 0,
+}
+
+xpu_test_src = """
+#include "kernel.h"
+
+int main() {
+  sycl::queue queue;
+  int M = 16, N = 16, K = 16;
+  void *A = sycl::malloc_device(M * K * 2, queue);
+  void *B = sycl::malloc_device(K * N * 2, queue);
+  void *C = sycl::malloc_device(M * N * 4, queue);
+  load_matmul_fp16();
+  ze_result_t ret = matmul_fp16_default(queue, C, A, B, M, N, K, N, 1, K, 1, N, 1);
+  queue.wait();
+  unload_matmul_fp16();
+  return ret != ZE_RESULT_SUCCESS;
+}
+"""
+
+
+def test_compile_link_matmul_xpu():
+    # Only checks that the generated launchers compile, which doesn't need a device.
+    icpx = shutil.which("icpx")
+    if icpx is None:
+        pytest.skip("icpx is needed to compile the SYCL launchers")
+
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        dtype = "fp16"
+        BM, BN, BK = 16, 16, 16
+
+        kernel_path = write_triton_kernels(tmp_dir, kernel_src, kernel_utils_src)
+        extra_args = ["--target", "xpu", "--device-props", json.dumps(xpu_device_props)]
+        compile_aot_kernels(tmp_dir, kernel_path, dtype, BM, BN, BK, ha_hb_hints=["", ":16"], extra_args=extra_args)
+        link_aot_kernels(tmp_dir)
+        assert len(glob.glob(os.path.join(tmp_dir, "matmul_fp16.*.cpp"))) == 4
+
+        with open(os.path.join(tmp_dir, "test.cpp"), "w") as file:
+            file.write(xpu_test_src)
+        cpp_files = glob.glob(os.path.join(tmp_dir, "*.cpp"))
+        subprocess.run([icpx, "-fsycl", "-fsyntax-only"] + cpp_files, check=True, cwd=tmp_dir)
+
+
 def test_ttgir_to_ptx():
     src = """
 module attributes {"triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 32 : i32, "triton_gpu.num-ctas" = 1 : i32} {
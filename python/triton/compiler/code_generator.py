@@ -1280,7 +1280,7 @@ def ast_to_ttir(fn, specialization, context, options, codegen_fns):
     function_name = fn.repr(specialization)
     tys = list(specialization.signature.values())
     new_constants = {k: True if k in tys and tys[k] == "i1" else 1 for k in attrs.equal_to_1}
-    new_attrs = {k: [("tt.divisibility", 16)] for k in attrs.divisible_by_16}
+    new_attrs = {k: [("tt.divisibility", attrs.get_divisibility(k))] for k in attrs.divisible_by_16}
 
     all_constants = constants.copy()
     all_constants.update(new_constants)
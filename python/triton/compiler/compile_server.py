@@ -0,0 +1,279 @@
+"""
+Local compile server, shared by the processes of a node.
+
+Each process otherwise runs the whole compilation pipeline itself. When
+`TRITON_COMPILE_SERVER` is set to the Unix socket of a server started with
+`triton-compile-server`, `compile` sends the kernels missing from the cache to
+the server instead. The server compiles them on a pool of long-lived worker
+processes, whose warm MLIR contexts are reused across compilations, and writes
+them to the shared file cache, from which the requesting process loads them.
+Concurrent requests for the same kernel are only compiled once.
+
+`compile` falls back to compiling in process whenever the server can't be
+used: no server is running, the kernel can't be imported by the server (e.g. it
+is defined in `__main__` or in a function), the server computes another cache
+key, the compilation fails...
+
+The server imports the modules of the kernels it is asked to compile, the
+socket is therefore only accessible to the user running the server.
+"""
+
+import functools
+import importlib
+import json
+import multiprocessing
+import os
+import socket
+import socketserver
+import struct
+import sys
+import threading
+from argparse import ArgumentParser
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Optional
+
+PROTOCOL_VERSION = 1
+
+
+def _send(sock, message: dict):
+    data = json.dumps(message).encode("utf-8")
+    sock.sendall(struct.pack("!I", len(data)) + data)
+
+
+def _recv(sock) -> dict:
+
+    def recv_exactly(size):
+        data = b""
+        while len(data) < size:
+            chunk = sock.recv(size - len(data))
+            if not chunk:
+                raise ConnectionError("connection closed by the compile server")
+            data += chunk
+        return data
+
+    size, = struct.unpack("!I", recv_exactly(4))
+    return json.loads(recv_exactly(size).decode("utf-8"))
+
+
+# ----- client -----
+
+
+def _module_root(module_name: str, path: str) -> str:
+    # directory from which `module_name` is imported, e.g. `root` for `root/a/b.py` and `a.b`
+    path = Path(path).resolve()
+    if path.name == "__init__.py":
+        path = path.parent
+    return str(path.parents[len(module_name.split(".")) - 1])
+
+
+def encode_source(src) -> Optional[dict]:
+    from .compiler import ASTSource
+    if not isinstance(src, ASTSource):
+        return {"kind": "ir", "path": os.path.abspath(src.path)}
+    fn = src.fn
+    module = sys.modules.get(fn.module)
+    path = getattr(module, "__file__", None)
+    qualname = fn.fn.__qualname__
+    if fn.module == "__main__" or path is None or "<locals>" in qualname:
+        return None
+    return {
+        "kind": "ast",
+        "module": fn.module,
+        "root": _module_root(fn.module, path),
+        "qualname": qualname,
+        # keys may be indices or names, which JSON objects would mix up
+        "signature": list(src.signature.items()),
+        "constants": list(src.constants.items()),
+        "attrs": src.attrs.to_dict(),
+    }
+
+
+def compile_on_server(address: str, src, target, options, cache_manager, key: str) -> bool:
+    """
+    Asks the server listening on `address` to compile `src` into the cache of
+    `cache_manager`. Returns whether the server compiled the kernel of cache
+    key `key`, in which case it can be loaded from the cache.
+    """
+    from ..runtime.cache import FileCacheManager
+    from .._C.libtriton import get_cache_invalidating_env_vars
+    encoded_src = encode_source(src)
+    if not isinstance(cache_manager, FileCacheManager) or encoded_src is None:
+        return False
+    request = {
+        "version": PROTOCOL_VERSION,
+        "src": encoded_src,
+        "target": [target.backend, target.arch, target.warp_size],
+        "options": options or {},
+        "env_vars": get_cache_invalidating_env_vars(),
+        "cache_dir": os.path.dirname(os.path.abspath(cache_manager.cache_dir)),
+        "key": key,
+    }
+    timeout = float(os.getenv("TRITON_COMPILE_SERVER_TIMEOUT", "600"))
+    try:
+        with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+            sock.settimeout(timeout)
+            sock.connect(address)
+            _send(sock, request)
+            response = _recv(sock)
+    except (OSError, TypeError, ValueError):
+        # TypeError: e.g. constants which can't be serialized
+        return False
+    return response.get("ok", False) and response.get("key") == key
+
+
+# ----- server -----
+
+# modification times of the modules imported by a worker, to reload the edited ones
+_module_mtimes = {}
+
+
+def _import_kernel(src: dict):
+    from ..runtime.jit import JITFunction
+    if src["root"] not in sys.path:
+        sys.path.insert(0, src["root"])
+    module = importlib.import_module(src["module"])
+    mtime = os.path.getmtime(module.__file__)
+    if _module_mtimes.setdefault(src["module"], mtime) != mtime:
+        module = importlib.reload(module)
+        _module_mtimes[src["module"]] = mtime
+    fn = functools.reduce(getattr, src["qualname"].split("."), module)
+    # unwrap the autotuners and heuristics
+    while not isinstance(fn, JITFunction):
+        fn = fn.fn
+    return fn
+
+
+def decode_source(src: dict):
+    from .compiler import ASTSource, AttrsDescriptor
+    if src["kind"] == "ir":
+        return src["path"]
+    return ASTSource(fn=_import_kernel(src), signature=dict(src["signature"]), constants=dict(src["constants"]),
+                     attrs=AttrsDescriptor.from_dict(src["attrs"]))
+
+
+def _as_tuples(value):
+    # the options are tuples (e.g. `cluster_dims`) sent as JSON lists, their hash depends on it
+    if isinstance(value, list):
+        return tuple(_as_tuples(x) for x in value)
+    return value
+
+
+def _init_worker():
+    # the workers compile in process
+    os.environ.pop("TRITON_COMPILE_SERVER", None)
+
+
+def _compile(request: dict) -> str:
+    # runs in the worker processes
+    from .._C.libtriton import get_cache_invalidating_env_vars
+    from ..backends.compiler import GPUTarget
+    from .compiler import compile
+    # compile with the settings of the client, the cache key depends on them
+    for name in get_cache_invalidating_env_vars():
+        os.environ.pop(name, None)
+    os.environ.update(request["env_vars"])
+    os.environ["TRITON_CACHE_DIR"] = request["cache_dir"]
+    target = GPUTarget(*request["target"])
+    options = {name: _as_tuples(value) for name, value in request["options"].items()}
+    return compile(decode_source(request["src"]), target=target, options=options).hash
+
+
+class CompileServer(socketserver.ThreadingUnixStreamServer):
+    daemon_threads = True
+
+    def __init__(self, address: str, num_workers: int):
+        self.executor = ProcessPoolExecutor(num_workers, mp_context=multiprocessing.get_context("spawn"),
+                                            initializer=_init_worker)
+        # compilations in progress, by cache key
+        self.pending = {}
+        self.pending_lock = threading.Lock()
+        # only the user running the server can connect to the socket
+        umask = os.umask(0o177)
+        try:
+            super().__init__(address, CompileRequestHandler)
+        finally:
+            os.umask(umask)
+
+    def compile(self, request: dict) -> str:
+        key = request["key"]
+        with self.pending_lock:
+            future = self.pending.get(key)
+            submitted = future is None
+            if submitted:
+                future = self.executor.submit(_compile, request)
+                self.pending[key] = future
+        if submitted:
+            # outside of the lock, the callback runs right away if the future is done
+            future.add_done_callback(lambda _: self._done(key))
+        return future.result()
+
+    def _done(self, key):
+        with self.pending_lock:
+            self.pending.pop(key, None)
+
+    def server_close(self):
+        super().server_close()
+        self.executor.shutdown(wait=False)
+        if os.path.exists(self.server_address):
+            os.unlink(self.server_address)
+
+
+class CompileRequestHandler(socketserver.BaseRequestHandler):
+
+    def handle(self):
+        try:
+            request = _recv(self.request)
+            if request.get("version") != PROTOCOL_VERSION:
+                raise RuntimeError(f"unsupported protocol version {request.get('version')}")
+            response = {"ok": True, "key": self.server.compile(request)}
+        except Exception as e:
+            response = {"ok": False, "error": f"{type(e).__name__}: {e}"}
+        try:
+            _send(self.request, response)
+        except OSError:
+            pass
+
+
+def _remove_stale_socket(address: str):
+    if not os.path.exists(address):
+        return
+    with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+        try:
+            sock.connect(address)
+        except OSError:
+            # left behind by a server which didn't shut down
+            os.unlink(address)
+            return
+    raise RuntimeError(f"a compile server is already listening on {address}")
+
+
+desc = """
+Triton compile server:
+
+Compiles the kernels of the processes of a node which set TRITON_COMPILE_SERVER
+to the socket of the server, on a pool of worker processes. The kernels are
+written to the cache directory of the requesting process.
+"""
+
+
+def main(args=None):
+    parser = ArgumentParser(description=desc)
+    parser.add_argument("--socket", "-s", type=str, default=os.getenv("TRITON_COMPILE_SERVER"),
+                        help="Path of the Unix socket to listen on, TRITON_COMPILE_SERVER by default")
+    parser.add_argument("--workers", "-w", type=int, default=os.cpu_count(),
+                        help="Number of worker processes, the number of CPUs by default")
+    args = parser.parse_args(args)
+    if not args.socket:
+        parser.error("--socket or TRITON_COMPILE_SERVER is required")
+    _remove_stale_socket(args.socket)
+    with CompileServer(args.socket, args.workers) as server:
+        print(f"Triton compile server listening on {args.socket}", flush=True)
+        try:
+            server.serve_forever()
+        except KeyboardInterrupt:
+            pass
+
+
+if __name__ == "__main__":
+    main()
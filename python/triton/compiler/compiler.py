@@ -1,4 +1,5 @@
 from __future__ import annotations
+import contextlib
 import hashlib
 import json
 from .._C.libtriton import get_cache_invalidating_env_vars, ir
@@ -11,33 +12,50 @@ from ..runtime.driver import driver
 # TODO: this shouldn't be here
 from dataclasses import dataclass
 from .code_generator import ast_to_ttir
+from .compile_server import compile_on_server
+from collections import defaultdict
+from collections.abc import Mapping
 from pathlib import Path
 import re
 import functools
 import os
+import threading
 
 
 @dataclass
 class AttrsDescriptor:
     divisible_by_16: set = None
     equal_to_1: set = None
+    # alignment above 16 of the arguments of `divisible_by_16` known to be
+    # multiples of a larger power of two
+    divisibility: dict = None
 
     def __post_init__(self):
         if self.divisible_by_16 is None:
             self.divisible_by_16 = set()
         if self.equal_to_1 is None:
             self.equal_to_1 = set()
+        if self.divisibility is None:
+            self.divisibility = dict()
+
+    def get_divisibility(self, i):
+        return self.divisibility.get(i, 16)
 
     def to_dict(self):
-        return {'divisible_by_16': list(self.divisible_by_16), 'equal_to_1': list(self.equal_to_1)}
+        return {
+            'divisible_by_16': list(self.divisible_by_16), 'equal_to_1': list(self.equal_to_1), 'divisibility':
+            [[i, d] for i, d in self.divisibility.items()]
+        }
 
     @staticmethod
     def from_dict(data):
         return AttrsDescriptor(divisible_by_16=set(data.get('divisible_by_16', [])),
-                               equal_to_1=set(data.get('equal_to_1', [])))
+                               equal_to_1=set(data.get('equal_to_1', [])),
+                               divisibility={i: d
+                                             for i, d in data.get('divisibility', [])})
 
     def hash(self):
-        key = str([sorted(x) for x in self.__dict__.values()])
+        key = str([sorted(x.items()) if isinstance(x, dict) else sorted(x) for x in self.__dict__.values()])
         return hashlib.sha256(key.encode("utf-8")).hexdigest()
 
 
@@ -116,13 +134,35 @@ class ASTSource:
         return dict()
 
 
+# Magic number at the start of MLIR bytecode files.
+MLIR_BYTECODE_MAGIC = b"ML\xefR"
+
+
+def is_mlir_bytecode(path):
+    with open(path, "rb") as f:
+        return f.read(len(MLIR_BYTECODE_MAGIC)) == MLIR_BYTECODE_MAGIC
+
+
+def mlir_bytecode_to_text(path, backend):
+    context = ir.context()
+    ir.load_dialects(context)
+    backend.load_dialects(context)
+    module = ir.parse_mlir_module(str(path), context)
+    module.context = context
+    return str(module)
+
+
 class IRSource:
 
-    def __init__(self, path):
+    def __init__(self, path, backend=None):
         self.path = path
         path = Path(path)
         self.ext = path.suffix[1:]
-        self.src = path.read_text()
+        if self.ext in ["ttir", "ttgir"] and is_mlir_bytecode(path):
+            assert backend is not None, "a backend is needed to read MLIR bytecode"
+            self.src = mlir_bytecode_to_text(path, backend)
+        else:
+            self.src = path.read_text()
         match = re.search(prototype_pattern[self.ext], self.src, re.MULTILINE)
         self.name = match.group(1)
         signature = match.group(2)
@@ -223,6 +263,56 @@ def filter_traceback(e: BaseException):
         e.__traceback__ = frames[0]
 
 
+class ContextPool:
+    """
+    Keeps MLIR contexts with the dialects of a backend already loaded, so that
+    back-to-back compilations (e.g. of autotuning configs) do not set up a new
+    context each. The pooled contexts share a process-wide thread pool. As a
+    context keeps the attributes and types uniqued by all the compilations it
+    was used for, it is dropped after `max_uses` of them: until then, the
+    modules of those compilations stay alive in it, for up to 64 compilations
+    by default. Opt-in with `TRITON_CONTEXT_POOL=1`.
+    """
+
+    def __init__(self, max_uses=64):
+        self.max_uses = max_uses
+        self._lock = threading.Lock()
+        self._contexts = defaultdict(list)
+        self._uses = {}
+
+    def acquire(self, backend):
+        with self._lock:
+            contexts = self._contexts[type(backend)]
+            if contexts:
+                return contexts.pop()
+        context = ir.pooled_context()
+        ir.load_dialects(context)
+        backend.load_dialects(context)
+        return context
+
+    def release(self, backend, context):
+        # undo the per-compilation settings, e.g. those of `enable_debug`
+        context.reset()
+        with self._lock:
+            uses = self._uses.pop(id(context), 0) + 1
+            if uses < self.max_uses:
+                self._uses[id(context)] = uses
+                self._contexts[type(backend)].append(context)
+
+
+context_pool = ContextPool()
+
+
+def open_kernel(src, metadata_group, hash, cache_manager):
+    kernel = CompiledKernel(src, metadata_group, hash)
+    # the files of the kernel are read lazily, they are not evicted from the
+    # cache while it is alive
+    index = getattr(cache_manager, "index", None)
+    if index is not None:
+        index.keep_alive(cache_manager.key, kernel)
+    return kernel
+
+
 def compile(src, target=None, options=None):
     if target is None:
         target = driver.active.get_current_target()
@@ -232,8 +322,9 @@ def compile(src, target=None, options=None):
     # create backend
     if ir_source:
         assert isinstance(src, str), "source must be either AST or a filepath"
-        src = IRSource(src)
+        src = IRSource(src, backend)
     extra_options = src.parse_options()
+    user_options = options
     options = backend.parse_options(dict(options or dict(), **extra_options))
     # create cache manager
     env_vars = get_cache_invalidating_env_vars()
@@ -244,6 +335,9 @@ def compile(src, target=None, options=None):
     # core changes to make it easier to track kernels by hash.
     enable_override = os.environ.get("TRITON_KERNEL_OVERRIDE", "0") == "1"
     enable_ir_dump = os.environ.get("TRITON_KERNEL_DUMP", "0") == "1"
+    # Cache the MLIR stages as bytecode, which is smaller and faster to parse
+    # back. The text is only printed for dumps and when accessing `asm`.
+    store_ir_bytecode = os.environ.get("TRITON_STORE_IR_BYTECODE", "0") == "1"
     fn_override_manager = get_override_manager(src.hash()) if enable_override else None
     fn_dump_manager = get_dump_manager(src.hash()) if enable_ir_dump else None
     metadata_filename = f"{src.name}.json"
@@ -253,53 +347,84 @@ def compile(src, target=None, options=None):
     if not always_compile and metadata_path is not None:
         # cache hit!
         metadata = json.loads(Path(metadata_path).read_text())
-        return CompiledKernel(src, metadata_group, hash)
-    # initialize metadata
-    metadata = {
-        "hash": hash,
-        "target": target,
-        **options.__dict__,
-        **env_vars,
-    }
-    # run compilation pipeline  and populate metadata
-    stages = dict()
-    backend.add_stages(stages, options)
-    first_stage = list(stages.keys()).index(src.ext)
-    # when the source is an IR file, don't apply the passes related to this stage. This makes it easier to write IR level tests.
-    if ir_source:
-        first_stage += 1
-    context = ir.context()
-    ir.load_dialects(context)
-    backend.load_dialects(context)
-    codegen_fns = backend.get_codegen_implementation()
-    try:
-        module = src.make_ir(options, codegen_fns, context)
-    except Exception as e:
-        filter_traceback(e)
-        raise
-    use_ttgir_loc = os.environ.get("USE_TTGIR_LOC", "0") == "1"
-    for ext, compile_ir in list(stages.items())[first_stage:]:
-        next_module = compile_ir(module, metadata)
-        ir_filename = f"{src.name}.{ext}"
-        metadata_group[ir_filename] = fn_cache_manager.put(next_module, ir_filename)
-        if fn_dump_manager is not None:
-            fn_dump_manager.put(next_module, ir_filename)
-        if (fn_override_manager is not None and fn_override_manager.has_file(ir_filename)):
-            print(f"\nOverriding kernel with file {ir_filename}")
-            full_name = fn_override_manager.get_file(ir_filename)
-            next_module = parse(full_name, ext, context)
-        # use an env variable to parse ttgir from file
-        if use_ttgir_loc and ext == "ttgir":
-            ttgir_full_name = fn_cache_manager.get_file(ir_filename)
-            next_module.create_location_snapshot(ttgir_full_name)
-            print(f"Create new locations for {ttgir_full_name}")
-        module = next_module
-    # write-back metadata
-    metadata_group[metadata_filename] = fn_cache_manager.put(json.dumps(metadata, default=vars), metadata_filename,
-                                                             binary=False)
-    fn_cache_manager.put_group(metadata_filename, metadata_group)
+        return open_kernel(src, metadata_group, hash, fn_cache_manager)
+    # Compile on the local compile server if there is one, falling back to
+    # compiling in process if it fails for any reason.
+    compile_server = os.environ.get("TRITON_COMPILE_SERVER")
+    if compile_server and not always_compile and fn_override_manager is None and fn_dump_manager is None:
+        if compile_on_server(compile_server, src, target, user_options, fn_cache_manager, hash):
+            metadata_group = fn_cache_manager.get_group(metadata_filename) or {}
+            if metadata_filename in metadata_group:
+                return open_kernel(src, metadata_group, hash, fn_cache_manager)
+    # Only one process compiles a given kernel at a time, the others wait for
+    # it and then load the kernel from the cache.
+    compile_lock = contextlib.nullcontext() if always_compile else fn_cache_manager.compile_lock(metadata_filename)
+    with compile_lock:
+        if not always_compile:
+            metadata_group = fn_cache_manager.get_group(metadata_filename) or {}
+            if metadata_filename in metadata_group:
+                return open_kernel(src, metadata_group, hash, fn_cache_manager)
+        # initialize metadata
+        metadata = {
+            "hash": hash,
+            "target": target,
+            **options.__dict__,
+            **env_vars,
+        }
+        # run compilation pipeline  and populate metadata
+        stages = dict()
+        backend.add_stages(stages, options)
+        first_stage = list(stages.keys()).index(src.ext)
+        # when the source is an IR file, don't apply the passes related to this stage.
+        # This makes it easier to write IR level tests.
+        if ir_source:
+            first_stage += 1
+        use_context_pool = os.environ.get("TRITON_CONTEXT_POOL", "0") == "1"
+        if use_context_pool:
+            context = context_pool.acquire(backend)
+        else:
+            context = ir.context()
+            ir.load_dialects(context)
+            backend.load_dialects(context)
+        try:
+            codegen_fns = backend.get_codegen_implementation()
+            try:
+                module = src.make_ir(options, codegen_fns, context)
+            except Exception as e:
+                filter_traceback(e)
+                raise
+            use_ttgir_loc = os.environ.get("USE_TTGIR_LOC", "0") == "1"
+            for ext, compile_ir in list(stages.items())[first_stage:]:
+                next_module = compile_ir(module, metadata)
+                ir_filename = f"{src.name}.{ext}"
+                # the ttgir locations refer to the lines of the cached text
+                keep_text = use_ttgir_loc and ext == "ttgir"
+                if store_ir_bytecode and ext in ["ttir", "ttgir"] and not keep_text:
+                    ir_data = next_module.bytecode(f"Triton {__version__}")
+                else:
+                    ir_data = next_module
+                metadata_group[ir_filename] = fn_cache_manager.put(ir_data, ir_filename)
+                if fn_dump_manager is not None:
+                    fn_dump_manager.put(next_module, ir_filename)
+                if (fn_override_manager is not None and fn_override_manager.has_file(ir_filename)):
+                    print(f"\nOverriding kernel with file {ir_filename}")
+                    full_name = fn_override_manager.get_file(ir_filename)
+                    next_module = parse(full_name, ext, context)
+                # use an env variable to parse ttgir from file
+                if use_ttgir_loc and ext == "ttgir":
+                    ttgir_full_name = fn_cache_manager.get_file(ir_filename)
+                    next_module.create_location_snapshot(ttgir_full_name)
+                    print(f"Create new locations for {ttgir_full_name}")
+                module = next_module
+        finally:
+            if use_context_pool:
+                context_pool.release(backend, context)
+        # write-back metadata
+        metadata_group[metadata_filename] = fn_cache_manager.put(json.dumps(metadata, default=vars), metadata_filename,
+                                                                 binary=False)
+        fn_cache_manager.put_group(metadata_filename, metadata_group)
     # return handle to compiled kernel
-    return CompiledKernel(src, metadata_group, hash)
+    return open_kernel(src, metadata_group, hash, fn_cache_manager)
 
 
 def make_backend(target):
@@ -326,6 +451,53 @@ class LazyDict:
         self.extras.append((func, args))
 
 
+class AsmDict(Mapping):
+    """
+    Maps each IR level generated during compilation to its text (or binary).
+    Files are only read from disk on first access, as most of them are never
+    needed to launch the kernel. MLIR stages cached as bytecode are printed
+    back to text using the dialects of `backend`.
+    """
+
+    def __init__(self, files, binary_ext, backend):
+        self._files = {file.suffix[1:]: file for file in files}
+        self._binary_ext = binary_ext
+        self._backend = backend
+        self._cache = {}
+
+    def __getitem__(self, key):
+        if key not in self._cache:
+            file = self._files[key]
+            try:
+                if key == self._binary_ext:
+                    self._cache[key] = file.read_bytes()
+                elif key in ["ttir", "ttgir"] and is_mlir_bytecode(file):
+                    self._cache[key] = mlir_bytecode_to_text(file, self._backend)
+                else:
+                    self._cache[key] = file.read_text()
+            except FileNotFoundError as e:
+                # e.g. evicted from the cache, only compiling the kernel again can write it back
+                raise RuntimeError(f"The {key} of kernel {file.stem} was removed from the cache directory "
+                                   f"{file.parent} since the kernel was loaded, compile the kernel again to "
+                                   "regenerate it") from e
+        return self._cache[key]
+
+    def __iter__(self):
+        return iter(self._files)
+
+    def __len__(self):
+        return len(self._files)
+
+    def __repr__(self):
+        return f"{self.__class__.__name__}({list(self._files)})"
+
+
+@functools.lru_cache()
+def _get_device_properties(utils, device):
+    # Device properties never change, only query them once per device.
+    return utils.get_device_properties(device)
+
+
 class CompiledKernel:
 
     # Hooks for external tools to monitor the execution of triton kernels
@@ -350,12 +522,8 @@ class CompiledKernel:
         self.name = self.metadata.name
         # stores the text of each level of IR that was generated during compilation
         asm_files = [Path(p) for c, p in metadata_group.items() if not c.endswith(".json")]
-        binary_ext = backend.binary_ext
-        self.asm = {
-            file.suffix[1:]: file.read_bytes() if file.suffix[1:] == binary_ext else file.read_text()
-            for file in asm_files
-        }
-        self.kernel = self.asm[binary_ext]
+        self.asm = AsmDict(asm_files, backend.binary_ext, backend)
+        self.kernel = self.asm[backend.binary_ext]
         # binaries are lazily initialized
         # because it involves doing runtime things
         # (e.g., checking amount of shared memory on current device)
@@ -369,12 +537,23 @@ class CompiledKernel:
         # create launcher
         self.run = driver.active.launcher_cls(self.src, self.metadata)
         # not enough shared memory to run the kernel
-        max_shared = driver.active.utils.get_device_properties(device)["max_shared_mem"]
+        max_shared = _get_device_properties(driver.active.utils, device)["max_shared_mem"]
         if self.metadata.shared > max_shared:
             raise OutOfResources(self.metadata.shared, max_shared, "shared memory")
+        # the resources of the kernel built for the device (registers, spills, private and local memory) are only
+        # known when loading it, add them to the metadata then
+        utils = driver.active.utils
+        resources = {}
+        if hasattr(utils, "get_kernel_resources"):
+            resources = utils.get_kernel_resources(self.name, self.kernel, device)
         # TODO: n_regs, n_spills should be metadata generated when calling `ptxas`
-        self.module, self.function, self.n_regs, self.n_spills = driver.active.utils.load_binary(
+        self.module, self.function, self.n_regs, self.n_spills = utils.load_binary(
             self.name, self.kernel, self.metadata.shared, device)
+        if resources:
+            from collections import namedtuple
+            metadata = {**self.metadata._asdict(), **resources}
+            KernelMetadata = namedtuple('KernelMetadata', sorted(list(metadata.keys())))
+            self.metadata = KernelMetadata(**metadata)
 
     def __getattribute__(self, name):
         if name == 'run':
@@ -7,6 +7,7 @@ import inspect
 from typing import Dict
 
 from ..testing import do_bench, do_bench_cudagraph
+from .driver import driver
 from .jit import KernelInterface
 from .errors import OutOfResources
 
@@ -33,6 +34,7 @@ class Autotuner(KernelInterface):
             'perf_model': performance model used to predicate running time with different configs, returns running time
             'top_k': number of configs to bench
             'prune_num_stages_by'(optional): a function used to prune num_stages. It takes configs:List[Config] as its input, and returns pruned configs.
+            'max_spills'(optional): configs whose compiled kernel spills more than this number of bytes are not benchmarked.
         """
         if not configs:
             self.configs = [Config({}, num_warps=4, num_stages=2, num_ctas=1)]
@@ -79,10 +81,12 @@ class Autotuner(KernelInterface):
         self.perf_model = None
         self.configs_top_k = 1.0
         self.early_config_prune = None
+        self.max_spills = None
         if prune_configs_by:
             self.perf_model = prune_configs_by.get("perf_model", self.perf_model)
             self.configs_top_k = prune_configs_by.get("top_k", self.configs_top_k)
             self.early_config_prune = prune_configs_by.get("early_config_prune", self.early_config_prune)
+            self.max_spills = prune_configs_by.get("max_spills", self.max_spills)
 
         self.fn = fn
         self.base_fn = fn
@@ -194,8 +198,34 @@ class Autotuner(KernelInterface):
                     for config in pruned_configs
                 }
                 pruned_configs = sorted(est_timing.keys(), key=lambda x: est_timing[x])[:top_k]
+        if self.max_spills is not None and len(pruned_configs) > 1:
+            pruned_configs = self.prune_spilling_configs(pruned_configs, kwargs)
         return pruned_configs
 
+    def prune_spilling_configs(self, configs, kwargs):
+        # Compile the kernel of each config (reused when benchmarking) and build it for the current device to read its
+        # spill size, if the driver can report it. The configs spilling the least are kept if all of them spill.
+        utils = driver.active.utils
+        if not hasattr(utils, "get_kernel_resources"):
+            return configs
+        device = driver.active.get_current_device()
+        kernels = {}
+        n_spills = {}
+        for config in configs:
+            kernel = self.fn.run(**self.nargs, **kwargs, **config.all_kwargs(), grid=None, warmup=True)
+            if kernel is not None:
+                kernels[config] = kernel
+                # the driver keeps the build for loading the kernel
+                n_spills[config] = utils.get_kernel_resources(kernel.name, kernel.kernel, device)["n_spills"]
+            else:
+                n_spills[config] = 0
+        max_spills = builtins.max(self.max_spills, builtins.min(n_spills.values()))
+        # the kernels of the pruned configs are not loaded, release their build
+        for config, kernel in kernels.items():
+            if n_spills[config] > max_spills:
+                utils.release_kernel_resources(kernel.kernel, device)
+        return [config for config in configs if n_spills[config] <= max_spills]
+
     def warmup(self, *args, **kwargs):
         self.nargs = dict(zip(self.arg_names, args))
         ret = []
@@ -226,16 +256,21 @@ class Config:
     :type maxnreg: Optional[int]
     :ivar maxnreg: maximum number of registers one thread can use.  Corresponds
                        to ptx .maxnreg directive.  Not supported on all platforms.
+    :type threads_per_warp: Optional[int]
+    :ivar threads_per_warp: number of threads per warp (sub-group size) on XPU. Chosen by the compiler
+                       from the content of the kernel if not set, e.g. to autotune over 16 and 32.
     :ivar pre_hook: a function that will be called before the kernel is called. Parameters of this
                     function are args.
     """
 
-    def __init__(self, kwargs, num_warps=4, num_stages=2, num_ctas=1, maxnreg=None, pre_hook=None):
+    def __init__(self, kwargs, num_warps=4, num_stages=2, num_ctas=1, maxnreg=None, pre_hook=None,
+                 threads_per_warp=None):
         self.kwargs = kwargs
         self.num_warps = num_warps
         self.num_ctas = num_ctas
         self.num_stages = num_stages
         self.maxnreg = maxnreg
+        self.threads_per_warp = threads_per_warp
         self.pre_hook = pre_hook
 
     def all_kwargs(self):
@@ -247,6 +282,7 @@ class Config:
                     ("num_ctas", self.num_ctas),
                     ("num_stages", self.num_stages),
                     ("maxnreg", self.maxnreg),
+                    ("threads_per_warp", self.threads_per_warp),
                 ) if v is not None
             }
         }
@@ -259,6 +295,8 @@ class Config:
         res.append(f"num_ctas: {self.num_ctas}")
         res.append(f"num_stages: {self.num_stages}")
         res.append(f"maxnreg: {self.maxnreg}")
+        if self.threads_per_warp is not None:
+            res.append(f"threads_per_warp: {self.threads_per_warp}")
         return ", ".join(res)
 
 
@@ -297,6 +335,8 @@ def autotune(configs, key, prune_configs_by=None, reset_to_zero=None, restore_va
         'perf_model': performance model used to predicate running time with different configs, returns running time
         'top_k': number of configs to bench
         'early_config_prune'(optional): a function used to do early prune (eg, num_stages). It takes configs:List[Config] as its input, and returns pruned configs.
+        'max_spills'(optional): configs whose compiled kernel spills more than this number of bytes (as reported in the
+        kernel metadata by the backend) are not benchmarked.
     :param reset_to_zero: a list of argument names whose value will be reset to zero before evaluating any configs.
     :type reset_to_zero: list[str]
     :param restore_value: a list of argument names whose value will be restored after evaluating any configs.
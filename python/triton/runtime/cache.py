@@ -1,7 +1,15 @@
+import atexit
+import contextlib
 import importlib
 import json
 import os
+import shutil
+import socket
+import sqlite3
+import time
 import uuid
+import warnings
+import weakref
 from abc import ABC, abstractmethod
 from pathlib import Path
 from typing import Dict, List, Optional
@@ -20,6 +28,227 @@ def default_dump_dir():
     return os.path.join(Path.home(), ".triton", "dump")
 
 
+def parse_cache_size(size: str) -> int:
+    """
+    Parses a size in bytes with an optional binary unit suffix, e.g. "512M"
+    or "10GB".
+    """
+    units = {"": 1, "K": 2**10, "M": 2**20, "G": 2**30, "T": 2**40}
+    size = size.strip().upper()
+    if size.endswith("B"):
+        size = size[:-1]
+    unit = size[-1] if size and size[-1] in units else ""
+    return int(float(size[:len(size) - len(unit)]) * units[unit])
+
+
+class CacheIndex:
+    """
+    SQLite index of the kernel directories of a file cache, with their size
+    and last access time, used to evict the least recently used ones when the
+    cache grows over a size cap.
+
+    The index is best effort: SQLite locking is unreliable on some network
+    file systems, so its errors never fail a compilation, and `triton-cache
+    rebuild` resynchronizes it with the directories of the cache.
+    """
+
+    filename = "index.sqlite"
+    # accesses are written at most every `flush_interval` seconds, in a single
+    # transaction, so that loading a kernel from the cache doesn't write
+    flush_interval = 60
+    # entries read at a time when evicting
+    evict_batch_size = 64
+
+    def __init__(self, cache_dir):
+        self.cache_dir = cache_dir
+        self.path = os.path.join(cache_dir, CacheIndex.filename)
+        self._initialized = False
+        # keys accessed since the last flush, with their access time
+        self._accesses = {}
+        self._last_flush = time.time()
+        # kernels of this process still alive by key, their files may be read
+        # lazily and are not evicted by it
+        self._opened = {}
+        self._warned = False
+
+    @contextlib.contextmanager
+    def _connect(self):
+        conn = sqlite3.connect(self.path, timeout=60, isolation_level=None)
+        try:
+            # the cache directory may have been cleared since
+            if not self._initialized or os.path.getsize(self.path) == 0:
+                self._create_schema(conn)
+                self._initialized = True
+            yield conn
+        finally:
+            conn.close()
+
+    @staticmethod
+    def _create_schema(conn):
+        # The size of the cache is kept up to date by triggers, so that it
+        # can be checked without scanning the entries.
+        conn.execute("BEGIN IMMEDIATE")
+        conn.execute("CREATE TABLE IF NOT EXISTS entries "
+                     "(key TEXT PRIMARY KEY, size INTEGER NOT NULL, last_access REAL NOT NULL)")
+        conn.execute("CREATE INDEX IF NOT EXISTS entries_by_last_access ON entries (last_access)")
+        conn.execute("CREATE TABLE IF NOT EXISTS total (size INTEGER NOT NULL)")
+        conn.execute("INSERT INTO total SELECT (SELECT COALESCE(SUM(size), 0) FROM entries) "
+                     "WHERE NOT EXISTS (SELECT * FROM total)")
+        conn.execute("CREATE TRIGGER IF NOT EXISTS entries_insert AFTER INSERT ON entries "
+                     "BEGIN UPDATE total SET size = size + new.size; END")
+        conn.execute("CREATE TRIGGER IF NOT EXISTS entries_delete AFTER DELETE ON entries "
+                     "BEGIN UPDATE total SET size = size - old.size; END")
+        conn.execute("CREATE TRIGGER IF NOT EXISTS entries_update AFTER UPDATE OF size ON entries "
+                     "BEGIN UPDATE total SET size = size - old.size + new.size; END")
+        conn.execute("COMMIT")
+
+    @contextlib.contextmanager
+    def _best_effort(self):
+        try:
+            yield
+        except sqlite3.Error as e:
+            if not self._warned:
+                self._warned = True
+                warnings.warn(f"Triton cache index {self.path} is unavailable ({e}), the cache is not pruned. "
+                              "Run `triton-cache rebuild` to recreate it.")
+
+    def _entry_size(self, key) -> int:
+        size = 0
+        for entry in os.scandir(os.path.join(self.cache_dir, key)):
+            with contextlib.suppress(FileNotFoundError):
+                size += entry.stat().st_size
+        return size
+
+    def _is_in_use(self, key) -> bool:
+        # a compilation is writing to the directory
+        with contextlib.suppress(FileNotFoundError):
+            return any(name.endswith(".lock") for name in os.listdir(os.path.join(self.cache_dir, key)))
+        return False
+
+    def record(self, key):
+        """Records the size of the directory of `key` and marks it as used."""
+        self._accesses.pop(key, None)
+        with self._best_effort(), self._connect() as conn:
+            conn.execute(
+                "INSERT INTO entries VALUES (?, ?, ?) ON CONFLICT(key) DO UPDATE SET size = excluded.size, "
+                "last_access = excluded.last_access", (key, self._entry_size(key), time.time()))
+
+    def touch(self, key):
+        """Marks `key` as used, the access is written with the next flush."""
+        self._accesses[key] = time.time()
+        if time.time() - self._last_flush > self.flush_interval:
+            self.flush()
+
+    def keep_alive(self, key, kernel):
+        """Keeps the directory of `key` from being evicted by this process while `kernel` is alive."""
+        self._opened.setdefault(key, weakref.WeakSet()).add(kernel)
+
+    def _is_opened(self, key) -> bool:
+        kernels = self._opened.get(key)
+        if kernels is None:
+            return False
+        if not kernels:
+            del self._opened[key]
+            return False
+        return True
+
+    def flush(self):
+        """Writes the accesses recorded by `touch`."""
+        accesses, self._accesses = self._accesses, {}
+        self._last_flush = time.time()
+        if not accesses:
+            return
+        with self._best_effort(), self._connect() as conn:
+            conn.execute("BEGIN IMMEDIATE")
+            new_keys = []
+            for key, last_access in accesses.items():
+                updated = conn.execute("UPDATE entries SET last_access = MAX(last_access, ?) WHERE key = ?",
+                                       (last_access, key)).rowcount
+                # the directory predates the index
+                if not updated and os.path.isdir(os.path.join(self.cache_dir, key)):
+                    new_keys.append((key, self._entry_size(key), last_access))
+            conn.executemany("INSERT OR IGNORE INTO entries VALUES (?, ?, ?)", new_keys)
+            conn.execute("COMMIT")
+
+    def evict(self, max_size=None, max_age=None, keep=(), dry_run=False):
+        """
+        Removes the least recently used directories until the cache holds at
+        most `max_size` bytes, as well as the ones not used for `max_age`
+        seconds. Returns the evicted keys. The directories of the kernels this
+        process still holds are kept.
+        """
+        evicted = []
+        cutoff = None if max_age is None else time.time() - max_age
+        with self._connect() as conn:
+            total_size, = conn.execute("SELECT size FROM total").fetchone()
+            # entries skipped, or evicted by a dry run, which are still in the table
+            offset = 0
+            while max_size is not None and total_size > max_size or cutoff is not None:
+                entries = conn.execute(
+                    "SELECT key, size, last_access FROM entries ORDER BY last_access LIMIT ? OFFSET ?",
+                    (self.evict_batch_size, offset)).fetchall()
+                if not entries:
+                    break
+                for key, size, last_access in entries:
+                    too_old = cutoff is not None and last_access < cutoff
+                    too_large = max_size is not None and total_size > max_size
+                    # the next entries are more recent
+                    if not (too_old or too_large):
+                        return evicted
+                    if key in keep or self._is_opened(key) or self._is_in_use(key):
+                        offset += 1
+                        continue
+                    if dry_run:
+                        offset += 1
+                    else:
+                        shutil.rmtree(os.path.join(self.cache_dir, key), ignore_errors=True)
+                        conn.execute("DELETE FROM entries WHERE key = ?", (key, ))
+                    total_size -= size
+                    evicted.append(key)
+        return evicted
+
+    def prune(self, max_size, keep=()):
+        """Evicts down to `max_size` bytes after a compilation, errors of the index are only reported."""
+        self.flush()
+        with self._best_effort():
+            self.evict(max_size=max_size, keep=keep)
+
+    def rebuild(self):
+        """
+        Synchronizes the index with the directories of the cache, e.g. after
+        they were written by processes not using the index.
+        """
+        keys = {entry.name for entry in os.scandir(self.cache_dir) if entry.is_dir()}
+        with self._connect() as conn:
+            indexed = {key for key, in conn.execute("SELECT key FROM entries")}
+            for key in indexed - keys:
+                conn.execute("DELETE FROM entries WHERE key = ?", (key, ))
+            for key in keys - indexed:
+                last_access = os.path.getmtime(os.path.join(self.cache_dir, key))
+                conn.execute("INSERT INTO entries VALUES (?, ?, ?)", (key, self._entry_size(key), last_access))
+
+    def stats(self):
+        with self._connect() as conn:
+            count, size, oldest, newest = conn.execute(
+                "SELECT COUNT(*), COALESCE(SUM(size), 0), MIN(last_access), MAX(last_access) FROM entries").fetchone()
+        return {"entries": count, "size": size, "oldest_access": oldest, "newest_access": newest}
+
+
+# indexes by cache directory, shared by the cache managers of the process
+_cache_indexes: Dict[str, CacheIndex] = {}
+
+
+def get_cache_index(cache_dir) -> Optional[CacheIndex]:
+    if os.getenv("TRITON_CACHE_INDEX", "0") != "1" and not os.getenv("TRITON_CACHE_MAX_SIZE"):
+        return None
+    if cache_dir not in _cache_indexes:
+        index = CacheIndex(cache_dir)
+        # write the last accesses of the process
+        atexit.register(index.flush)
+        _cache_indexes[cache_dir] = index
+    return _cache_indexes[cache_dir]
+
+
 class CacheManager(ABC):
 
     def __init__(self, key):
@@ -41,12 +270,21 @@ class CacheManager(ABC):
     def put_group(self, filename: str, group: Dict[str, str]):
         pass
 
+    def compile_lock(self, filename: str):
+        """
+        Context manager held while compiling the group `filename`, so that
+        processes compiling the same kernel can wait for a single one of them
+        to produce it instead of duplicating the work.
+        """
+        return contextlib.nullcontext()
+
 
 class FileCacheManager(CacheManager):
 
     def __init__(self, key, override=False, dump=False):
         self.key = key
         self.lock_path = None
+        self.index = None
         if dump:
             self.cache_dir = default_dump_dir()
             self.cache_dir = os.path.join(self.cache_dir, self.key)
@@ -59,6 +297,7 @@ class FileCacheManager(CacheManager):
             # create cache directory if it doesn't exist
             self.cache_dir = os.getenv("TRITON_CACHE_DIR", "").strip() or default_cache_dir()
             if self.cache_dir:
+                self.index = get_cache_index(self.cache_dir)
                 self.cache_dir = os.path.join(self.cache_dir, self.key)
                 self.lock_path = os.path.join(self.cache_dir, "lock")
                 os.makedirs(self.cache_dir, exist_ok=True)
@@ -94,6 +333,8 @@ class FileCacheManager(CacheManager):
         for c, p in child_paths.items():
             if os.path.exists(p):
                 result[c] = p
+        if self.index is not None:
+            self.index.touch(self.key)
         return result
 
     # Note a group of pushed files as being part of a group
@@ -102,7 +343,94 @@ class FileCacheManager(CacheManager):
             raise RuntimeError("Could not create or locate cache dir")
         grp_contents = json.dumps({"child_paths": group})
         grp_filename = f"__grp__{filename}"
-        return self.put(grp_contents, grp_filename, binary=False)
+        grp_filepath = self.put(grp_contents, grp_filename, binary=False)
+        if self.index is not None:
+            self.index.record(self.key)
+            max_size = os.getenv("TRITON_CACHE_MAX_SIZE")
+            if max_size:
+                self.index.prune(parse_cache_size(max_size), keep=(self.key, ))
+        return grp_filepath
+
+    @contextlib.contextmanager
+    def compile_lock(self, filename: str):
+        # The lock is a file created exclusively by the compiling process,
+        # which records its host, pid and a random token. It is stale if that
+        # process is gone, or if it has been held for longer than any
+        # compilation should take. The lock only avoids duplicated work: the
+        # groups are written atomically whoever holds it.
+        lock_path = self._make_path(f"{filename}.lock")
+        owner = f"{socket.gethostname()} {os.getpid()} {uuid.uuid4().hex}"
+        timeout = float(os.getenv("TRITON_COMPILE_LOCK_TIMEOUT", "600"))
+        while True:
+            try:
+                fd = os.open(lock_path, os.O_CREAT | os.O_EXCL | os.O_WRONLY)
+            except FileExistsError:
+                stale_owner = self._stale_lock_owner(lock_path, timeout)
+                if stale_owner is not None:
+                    self._break_lock(lock_path, stale_owner)
+                else:
+                    time.sleep(0.05)
+                continue
+            with os.fdopen(fd, "w") as f:
+                f.write(owner)
+            break
+        try:
+            yield
+        finally:
+            # the lock may have been broken as stale and taken by another process
+            if self._read_lock_owner(lock_path) == owner:
+                with contextlib.suppress(FileNotFoundError):
+                    os.remove(lock_path)
+
+    @staticmethod
+    def _read_lock_owner(lock_path) -> Optional[str]:
+        try:
+            with open(lock_path) as f:
+                return f.read()
+        except FileNotFoundError:
+            return None
+
+    @staticmethod
+    def _break_lock(lock_path, stale_owner):
+        # Rename the lock away rather than removing it, so that only one of
+        # the waiters finding it stale breaks it. The renamed lock is put back
+        # if it was taken by another process in the meantime.
+        broken_path = f"{lock_path}.{uuid.uuid4().hex}.broken"
+        try:
+            os.rename(lock_path, broken_path)
+        except FileNotFoundError:
+            return
+        if FileCacheManager._read_lock_owner(broken_path) != stale_owner:
+            with contextlib.suppress(FileExistsError):
+                os.link(broken_path, lock_path)
+        os.remove(broken_path)
+
+    @staticmethod
+    def _stale_lock_owner(lock_path, timeout) -> Optional[str]:
+        # Returns the owner recorded in the lock if the lock is stale.
+        owner = FileCacheManager._read_lock_owner(lock_path)
+        try:
+            age = time.time() - os.path.getmtime(lock_path)
+        except FileNotFoundError:
+            return None
+        if owner is None:
+            return None
+        if age > timeout:
+            return owner
+        fields = owner.split()
+        # the owner has not written its name yet
+        if len(fields) != 3:
+            return None
+        host, pid, _ = fields
+        if host != socket.gethostname():
+            return None
+        try:
+            os.kill(int(pid), 0)
+        except ProcessLookupError:
+            return owner
+        except (PermissionError, ValueError):
+            pass
+        return None
 
     def put(self, data, filename, binary=True) -> str:
         if not self.cache_dir:
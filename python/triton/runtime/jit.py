@@ -274,19 +274,53 @@ class KernelParam:
         return self._param.default != inspect.Parameter.empty
 
 
+def parse_alignment_tiers(tiers):
+    """
+    Parses a comma separated list of alignments in bytes (e.g. "16,32,64,128")
+    into the tuple of the powers of two above 16 to specialize on, from the
+    largest to the smallest.
+    """
+    alignments = {int(tier) for tier in tiers.split(",") if tier.strip()}
+    for alignment in alignments:
+        if alignment < 16 or alignment & (alignment - 1) != 0:
+            raise ValueError(f"Alignment tiers must be powers of two of at least 16, got {alignment}")
+    return tuple(sorted((alignment for alignment in alignments if alignment > 16), reverse=True))
+
+
+def get_alignment_tier(v):
+    """
+    Returns the largest alignment tier `v` is a multiple of, given that it is
+    a multiple of 16.
+    """
+    for alignment in JITFunction.alignment_tiers:
+        if v % alignment == 0:
+            return alignment
+    return 16
+
+
 def compute_spec_key(v):
 
     if hasattr(v, "data_ptr") and (v.data_ptr() % 16 == 0):
-        return "D"
+        alignment = get_alignment_tier(v.data_ptr())
+        return "D" if alignment == 16 else f"D{alignment}"
     elif isinstance(v, int):
         # bool is a subclass of int, so we don't check explicitly above.
         if (v % 16 == 0):
-            return "D"
+            alignment = get_alignment_tier(v)
+            return "D" if alignment == 16 else f"D{alignment}"
         elif v == 1:
             return "1"
     return "N"
 
 
+def drop_alignment_tiers(sig_and_spec):
+    """
+    Replaces the alignment tiers of the specialization keys of a signature by
+    the 16 bytes divisibility they imply.
+    """
+    return tuple("D" if s.startswith("D") else s for s in sig_and_spec)
+
+
 dtype2str = {}
 
 
@@ -437,6 +471,15 @@ class JITFunction(KernelInterface[T]):
     # Hook for inspecting compiled functions and modules
     cache_hook = None
     divisibility = 16
+    # Alignments above `divisibility` that pointers and integers are also
+    # specialized on, e.g. "16,32,64,128" so that the base and pitch of 2D
+    # block accesses are statically known to be aligned on 64 bytes. None by
+    # default: the compiler doesn't use a divisibility above 16 yet, the extra
+    # specializations would only recompile the same kernel.
+    alignment_tiers = parse_alignment_tiers(os.getenv("TRITON_ALIGNMENT_TIERS", "16"))
+    # Number of kernels per device that may be specialized on `alignment_tiers`,
+    # the following ones only use `divisibility`.
+    max_aligned_specializations = int(os.getenv("TRITON_MAX_ALIGNED_SPECIALIZATIONS", "8"))
 
     @staticmethod
     def _key_of(arg):
@@ -466,7 +509,7 @@ class JITFunction(KernelInterface[T]):
             return (arg % 16 == 0, arg == 1)
         return (arg is None, )
 
-    def _get_config(self, *args):
+    def _get_config(self, *args, use_alignment_tiers=True):
         from ..compiler import AttrsDescriptor
 
         def is_divisible_by_16(x):
@@ -483,6 +526,15 @@ class JITFunction(KernelInterface[T]):
             for param, arg in zip(self.params, args)
             if is_divisible_by_16(arg) and not param.do_not_specialize
         }
+        # alignment tiers above 16 bytes of the arguments divisible by 16
+        divisibility = {}
+        if use_alignment_tiers:
+            for param, arg in zip(self.params, args):
+                if param.num not in divisible_by_16 or arg is None:
+                    continue
+                alignment = get_alignment_tier(arg.data_ptr() if hasattr(arg, "data_ptr") else arg)
+                if alignment > JITFunction.divisibility:
+                    divisibility[param.num] = alignment
         equal_to_1 = {
             param.num
             for param, arg in zip(self.params, args)
@@ -490,7 +542,7 @@ class JITFunction(KernelInterface[T]):
         }
         # folded equal_to_1 and None
         # TODO: method to collect all folded args
-        return AttrsDescriptor(tuple(divisible_by_16), tuple(equal_to_1))
+        return AttrsDescriptor(tuple(divisible_by_16), tuple(equal_to_1), divisibility)
         # return _triton.code_gen.instance_descriptor(divisible_by_16,
         # equal_to_1)
 
@@ -603,6 +655,15 @@ class JITFunction(KernelInterface[T]):
         key = ''.join(sig_and_spec) + str((constexpr_vals, excess_kwargs))
         kernel = self.cache[device].get(key, None)
 
+        # Bound the number of kernels specialized on the alignment tiers, so
+        # that arguments taking many different alignments do not trigger as
+        # many compilations.
+        use_alignment_tiers = len(self.aligned_specializations[device]) < JITFunction.max_aligned_specializations
+        if kernel is None and not use_alignment_tiers:
+            sig_and_spec = drop_alignment_tiers(sig_and_spec)
+            key = ''.join(sig_and_spec) + str((constexpr_vals, excess_kwargs))
+            kernel = self.cache[device].get(key, None)
+
         if kernel is None:
             # Kernel is not cached; we have to compile.
             target = driver.active.get_current_target()
@@ -627,7 +688,7 @@ class JITFunction(KernelInterface[T]):
             sigvals = sig_and_spec[:len(sigkeys)]
             signature = {k: ('*i8' if (v == 'none') else v) for (k, v) in zip(sigkeys, sigvals)}
 
-            configs = (self._get_config(*bound_vals), )
+            configs = (self._get_config(*bound_vals, use_alignment_tiers=use_alignment_tiers), )
             constants = {
                 p.name: v
                 for (v, p) in zip(bound_vals, self.params)
@@ -647,6 +708,8 @@ class JITFunction(KernelInterface[T]):
                 options=options.__dict__,
             )
             self.cache[device][key] = kernel
+            if configs[0].divisibility:
+                self.aligned_specializations[device].add(key)
 
         # Check that used global values have not changed.
         not_present = object()
@@ -699,6 +762,8 @@ class JITFunction(KernelInterface[T]):
         self.src = self.src[re.search(r"^def\s+\w+\s*\(", self.src, re.MULTILINE).start():]
         # cache of just-in-time compiled kernels
         self.cache = defaultdict(dict)
+        # keys of the kernels specialized on alignment tiers above 16 bytes
+        self.aligned_specializations = defaultdict(set)
         self.hash = None
 
         # Map of global variables used by the function and any functions it
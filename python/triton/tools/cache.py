@@ -0,0 +1,68 @@
+"""
+Maintenance of the Triton kernel cache through its index, e.g.
+
+`triton-cache stats`
+`triton-cache prune --max-size 10G --max-age-days 30`
+
+The index is kept up to date by the processes that run with
+TRITON_CACHE_INDEX=1 or TRITON_CACHE_MAX_SIZE set; `rebuild` adds the
+directories written without it.
+"""
+
+import datetime
+import os
+from argparse import ArgumentParser
+
+from triton.runtime.cache import CacheIndex, default_cache_dir, parse_cache_size
+
+
+def format_size(size):
+    for unit in ["B", "KiB", "MiB", "GiB"]:
+        if size < 1024:
+            return f"{size:.1f} {unit}"
+        size /= 1024
+    return f"{size:.1f} TiB"
+
+
+def format_time(timestamp):
+    if timestamp is None:
+        return "-"
+    return datetime.datetime.fromtimestamp(timestamp).isoformat(sep=" ", timespec="seconds")
+
+
+def main(argv=None):
+    parser = ArgumentParser(description="Inspect and prune the Triton kernel cache")
+    parser.add_argument("--cache-dir", default=os.getenv("TRITON_CACHE_DIR", "").strip() or default_cache_dir(),
+                        help="cache directory (defaults to TRITON_CACHE_DIR or ~/.triton/cache)")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+    subparsers.add_parser("stats", help="print the number, size and access times of the cached kernels")
+    subparsers.add_parser("rebuild", help="synchronize the index with the cache directories")
+    prune = subparsers.add_parser("prune", help="evict the least recently used kernels")
+    prune.add_argument("--max-size", type=parse_cache_size, help="size to prune the cache to, e.g. 10G")
+    prune.add_argument("--max-age-days", type=float, help="evict the kernels not used for this many days")
+    prune.add_argument("--dry-run", action="store_true", help="only print the kernels that would be evicted")
+    args = parser.parse_args(argv)
+
+    if not os.path.isdir(args.cache_dir):
+        parser.error(f"{args.cache_dir} is not a directory")
+    index = CacheIndex(args.cache_dir)
+    if args.command == "rebuild":
+        index.rebuild()
+    elif args.command == "prune":
+        if args.max_size is None and args.max_age_days is None:
+            parser.error("prune needs --max-size or --max-age-days")
+        max_age = None if args.max_age_days is None else args.max_age_days * 24 * 3600
+        evicted = index.evict(max_size=args.max_size, max_age=max_age, dry_run=args.dry_run)
+        for key in evicted:
+            print(key)
+        print(f"{'Would evict' if args.dry_run else 'Evicted'} {len(evicted)} kernels")
+    stats = index.stats()
+    print(f"cache directory: {args.cache_dir}")
+    print(f"entries:         {stats['entries']}")
+    print(f"size:            {format_size(stats['size'])}")
+    print(f"oldest access:   {format_time(stats['oldest_access'])}")
+    print(f"newest access:   {format_time(stats['newest_access'])}")
+
+
+if __name__ == "__main__":
+    main()
@@ -1,21 +1,29 @@
 import binascii
 import hashlib
 import importlib.util
+import json
+import os
+import shutil
+import subprocess
 import sys
+import tempfile
 from argparse import ArgumentParser
 from pathlib import Path
 from typing import List
 
 import triton
+from triton.backends.compiler import GPUTarget
 from triton.compiler.code_generator import kernel_suffix
-from triton.backends.intel.driver import ty_to_cpp
 
 desc = """
 Triton ahead-of-time compiler:
 
 This program compiles the kernel with name `kernel-name` in the file at the
 provided `path` into self-contained C source-code that embeds the `cubin`
-data along with utilities to load, unload and launch the kernel.
+data along with utilities to load, unload and launch the kernel. With
+`--target xpu`, the generated SYCL C++ source embeds the SPIR-V of the kernel
+instead (and optionally a native binary built by `ocloc`) and loads it through
+Level Zero.
 
 signature is provided as a list of (optionally divisibility-hinted) types
 or constexpr values, e.g.
@@ -30,6 +38,10 @@ The resulting entry point will have signature
 
 CUresult kernel_{specialization_suffix}(CUstream stream, unsigned gX, unsigned gY, unsigned gZ, float* arg0, int32_t arg1, int32_t arg2)
 
+or, for XPU,
+
+ze_result_t kernel_{specialization_suffix}(sycl::queue &stream, void* arg0, int32_t arg1, int32_t arg2)
+
 Different such specialized entry points can be combined using the `linker.py` script.
 
 NOTE: when resolving the scope of /path/to/kernel.py, the file will be executed from within its parent directory with the python interpreter
@@ -51,8 +63,30 @@ if __name__ == "__main__":
     parser.add_argument("--out-path", "-o", type=Path, default=None, help="Out filename")
     parser.add_argument("--signature", "-s", type=str, help="Signature of the kernel", required=True)
     parser.add_argument("--grid", "-g", type=str, help="Launch grid of the kernel", required=True)
+    parser.add_argument("--target", "-t", type=str, default=None, choices=["cuda", "xpu"],
+                        help="Backend to compile the kernel for, the active one by default")
+    parser.add_argument(
+        "--device-props", type=str, default=None,
+        help="XPU only: JSON properties of the device to compile for (as returned by "
+        "torch.xpu.get_device_capability), so that no device is needed. The current device is used by default")
+    parser.add_argument(
+        "--native-device", type=str, default=None,
+        help="XPU only: also embed a native binary built by ocloc for this device (e.g. pvc). "
+        "The SPIR-V is built at load time on other devices")
     args = parser.parse_args()
 
+    if args.target is None:
+        args.target = triton.runtime.driver.active.get_current_target().backend
+    if args.target == "xpu":
+        from triton.backends.intel.driver import ty_to_cpp
+    else:
+        from triton.backends.nvidia.driver import ty_to_cpp
+    target = None
+    if args.device_props is not None:
+        assert args.target == "xpu", "--device-props is only supported for XPU"
+        target = GPUTarget("xpu", json.loads(args.device_props), 32)
+    assert args.native_device is None or args.target == "xpu", "--native-device is only supported for XPU"
+
     out_name = args.out_name if args.out_name else args.kernel_name
     out_path = args.out_path if args.out_path else Path(out_name)
 
@@ -109,7 +143,7 @@ if __name__ == "__main__":
         constants.update({i: 1})
     src = triton.compiler.ASTSource(fn=kernel, constants=constants, signature=signature, attrs=attrs)
     opts = {"num_warps": args.num_warps, "num_stages": args.num_stages}
-    ccinfo = triton.compile(src, options=opts)
+    ccinfo = triton.compile(src, target=target, options=opts)
     arg_names = []
     arg_types = []
     for i in signature.keys():
@@ -120,7 +154,8 @@ if __name__ == "__main__":
     # dump C stub code
     suffix = kernel_suffix(signature.values(), attrs)
     func_name = '_'.join([out_name, sig_hash, suffix])
-    hex_ = str(binascii.hexlify(ccinfo.asm["cubin"]))[2:-1]
+    binary = ccinfo.asm["spv" if args.target == "xpu" else "cubin"]
+    hex_ = str(binascii.hexlify(binary))[2:-1]
     params = {
         "kernel_name": func_name,
         "triton_kernel_name": args.kernel_name,
@@ -139,7 +174,34 @@ if __name__ == "__main__":
         "gridZ": grid[2],
         "_placeholder": "",
     }
-    for ext in ['h', 'c']:
-        template_path = Path(__file__).parent / f"compile.{ext}"
+    templates = {"h": "compile.h", "c": "compile.c"}
+    if args.target == "xpu":
+
+        def build_native(spv: bytes, device: str) -> bytes:
+            ocloc = shutil.which("ocloc")
+            assert ocloc is not None, "ocloc is needed to build a native binary"
+            with tempfile.TemporaryDirectory() as tmp_dir:
+                spv_path = os.path.join(tmp_dir, "kernel.spv")
+                Path(spv_path).write_bytes(spv)
+                subprocess.run([ocloc, "compile", "-file", spv_path, "-spirv_input", "-device", device, "-output",
+                                "kernel", "-output_no_suffix", "-q"], check=True, cwd=tmp_dir)
+                return Path(tmp_dir, "kernel.bin").read_bytes()
+
+        native = build_native(binary, args.native_device) if args.native_device else b""
+        native_hex = str(binascii.hexlify(native))[2:-1]
+        params.update({
+            "triton_kernel_name": ccinfo.metadata.name,
+            # The backend may have changed the number of warps, e.g. for warp specialization.
+            "num_warps": ccinfo.metadata.num_warps,
+            "bin_size": len(binary),
+            "native_size": len(native),
+            # Arrays can't be empty, the size above tells whether there is a native binary.
+            "native_data": ", ".join([f"0x{x}{y}" for x, y in zip(native_hex[::2], native_hex[1::2])]) or "0",
+            "arg_setters": " ".join([f"cgh.set_arg({i}, {arg});" for i, arg in enumerate(arg_names)]),
+            "threads_per_warp": ccinfo.metadata.threads_per_warp,
+        })
+        templates = {"h": "compile_xpu.h", "cpp": "compile_xpu.cpp"}
+    for ext, template in templates.items():
+        template_path = Path(__file__).parent / template
         with out_path.with_suffix(f".{sig_hash}_{suffix}.{ext}").open("w") as fp:
             fp.write(Path(template_path).read_text().format(**params))
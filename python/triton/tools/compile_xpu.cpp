@@ -0,0 +1,106 @@
+/* clang-format off */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <level_zero/ze_api.h>
+#include <sycl/sycl.hpp>
+
+
+// helpers to check for level zero errors
+#define ZE_CHECK(ans) {{\
+    gpuAssert((ans), __FILE__, __LINE__);\
+  }}\
+
+static inline void gpuAssert(ze_result_t code, const char *file, int line) {{
+  if (code != ZE_RESULT_SUCCESS) {{
+    fprintf(stderr, "Triton Error [ZE]: 0x%x at %s:%d\\n", code, file, line);
+    exit(code);
+  }}
+}}
+
+// globals
+#define SPV_NAME {kernel_name}_spv
+#define NATIVE_NAME {kernel_name}_native
+sycl::kernel *{kernel_name}_func = NULL;
+unsigned char SPV_NAME[{bin_size}] = {{ {bin_data} }};
+// native binary built for a given device, empty if none was requested
+size_t {kernel_name}_native_size = {native_size};
+unsigned char NATIVE_NAME[] = {{ {native_data} }};
+
+
+static ze_result_t create_module_{kernel_name}(ze_context_handle_t context, ze_device_handle_t device,
+                                               ze_module_format_t format, const unsigned char *bin, size_t size,
+                                               ze_module_handle_t *module) {{
+    ze_module_desc_t desc = {{}};
+    desc.stype = ZE_STRUCTURE_TYPE_MODULE_DESC;
+    desc.format = format;
+    desc.inputSize = size;
+    desc.pInputModule = bin;
+    desc.pBuildFlags = "";
+    return zeModuleCreate(context, device, &desc, module, NULL);
+}}
+
+void unload_{kernel_name}(void) {{
+    // the module and the kernel are owned by the sycl kernel
+    delete {kernel_name}_func;
+    {kernel_name}_func = NULL;
+}}
+
+// TODO: some code duplication with `third_party/intel/backend/driver.c`
+static void load_{kernel_name}(const sycl::device &device, const sycl::context &context) {{
+    auto l0_device = sycl::get_native<sycl::backend::ext_oneapi_level_zero>(device);
+    auto l0_context = sycl::get_native<sycl::backend::ext_oneapi_level_zero>(context);
+    ze_module_handle_t module = NULL;
+    // the native binary fails to load on other devices than the one it was built for, fall back to the SPIR-V
+    if ({kernel_name}_native_size == 0 ||
+        create_module_{kernel_name}(l0_context, l0_device, ZE_MODULE_FORMAT_NATIVE, NATIVE_NAME, {kernel_name}_native_size,
+                                    &module) != ZE_RESULT_SUCCESS)
+      ZE_CHECK(create_module_{kernel_name}(l0_context, l0_device, ZE_MODULE_FORMAT_IL_SPIRV, SPV_NAME,
+                                           sizeof(SPV_NAME), &module));
+    ze_kernel_desc_t kernel_desc = {{}};
+    kernel_desc.stype = ZE_STRUCTURE_TYPE_KERNEL_DESC;
+    kernel_desc.flags = ZE_KERNEL_FLAG_FORCE_RESIDENCY;
+    kernel_desc.pKernelName = "{triton_kernel_name}";
+    ze_kernel_handle_t kernel;
+    ZE_CHECK(zeKernelCreate(module, &kernel_desc, &kernel));
+    auto bundle = sycl::make_kernel_bundle<sycl::backend::ext_oneapi_level_zero, sycl::bundle_state::executable>(
+        {{module, sycl::ext::oneapi::level_zero::ownership::transfer}}, context);
+    {kernel_name}_func = new sycl::kernel(sycl::make_kernel<sycl::backend::ext_oneapi_level_zero>(
+        {{bundle, kernel, sycl::ext::oneapi::level_zero::ownership::transfer}}, context));
+}}
+
+// loads the kernel for the default GPU, launching it on another device loads it there instead
+void load_{kernel_name}(void) {{
+    sycl::device device(sycl::gpu_selector_v);
+    load_{kernel_name}(device, device.get_platform().ext_oneapi_get_default_context());
+}}
+
+/*
+{kernel_docstring}
+*/
+ze_result_t {kernel_name}(sycl::queue &stream, {signature}) {{
+    if ({kernel_name}_func == NULL)
+       load_{kernel_name}(stream.get_device(), stream.get_context());
+    unsigned int gX = {gridX};
+    unsigned int gY = {gridY};
+    unsigned int gZ = {gridZ};
+    if (gX * gY * gZ == 0)
+      return ZE_RESULT_SUCCESS;
+    size_t local_x = {num_warps} * {threads_per_warp};
+    sycl::nd_range<3> range(sycl::range<3>(gZ, gY, gX * local_x), sycl::range<3>(1, 1, local_x));
+    try {{
+      stream.submit([&](sycl::handler &cgh) {{
+        {arg_setters}
+        // shared memory is passed as a trailing local accessor
+        if ({shared} > 0)
+          cgh.set_arg({num_args}, sycl::local_accessor<int8_t, 1>({shared}, cgh));
+        cgh.parallel_for(range, *{kernel_name}_func);
+      }});
+    }} catch (const sycl::exception &e) {{
+      fprintf(stderr, "Triton Error [SYCL]: %s\\n", e.what());
+      return ZE_RESULT_ERROR_UNKNOWN;
+    }}
+    return ZE_RESULT_SUCCESS;
+}}
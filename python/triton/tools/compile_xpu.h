@@ -0,0 +1,15 @@
+#ifndef TT_KERNEL_INCLUDES
+#define TT_KERNEL_INCLUDES
+
+#include <inttypes.h>
+#include <level_zero/ze_api.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sycl/sycl.hpp>
+
+#endif
+
+void unload_{kernel_name}(void);
+void load_{kernel_name}(void);
+// tt-linker: {kernel_name}:{full_signature}:{algo_info}
+ze_result_t{_placeholder} {kernel_name}(sycl::queue &stream, {signature});
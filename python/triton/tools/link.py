@@ -13,6 +13,36 @@ class LinkerError(Exception):
     pass
 
 
+@dataclass
+class LinkerTarget:
+    includes: Sequence[str]
+    result_type: str
+    stream_decl: str
+    invalid_value: str
+    """ returned when no specialization matches the arguments """
+    source_ext: str
+
+
+TARGETS = {
+    "cuda":
+    LinkerTarget(
+        includes=["cuda.h"],
+        result_type="CUresult",
+        stream_decl="CUstream stream",
+        invalid_value="CUDA_ERROR_INVALID_VALUE",
+        source_ext="c",
+    ),
+    "xpu":
+    LinkerTarget(
+        includes=["level_zero/ze_api.h", "sycl/sycl.hpp"],
+        result_type="ze_result_t",
+        stream_decl="sycl::queue &stream",
+        invalid_value="ZE_RESULT_ERROR_INVALID_ARGUMENT",
+        source_ext="cpp",
+    ),
+}
+
+
 @dataclass
 class KernelLinkerMeta:
     orig_kernel_name: str
@@ -36,7 +66,7 @@ class HeaderParser:
         # [name, hash, suffix]
         self.kernel_name = re.compile("^([\\w]+)_([\\w]+)_([\\w]+)$")
         # [(type, name)]
-        self.c_sig = re.compile("[\\s]*(\\w+)\\s(\\w+)[,]?")
+        self.c_sig = re.compile("[\\s]*(\\w+\\*?)\\s(\\w+)[,]?")
         # [d|c]
         self.arg_suffix = re.compile("[c,d]")
 
@@ -131,51 +161,56 @@ def gen_signature(m):
 
 
 # generate declarations of kernels with meta-parameter and constant values
-def make_algo_decls(name: str, metas: Sequence[KernelLinkerMeta]) -> str:
+def make_algo_decls(name: str, metas: Sequence[KernelLinkerMeta], target: LinkerTarget = TARGETS["cuda"]) -> str:
     return f"""
-CUresult {name}(CUstream stream, {gen_signature_with_full_args(metas[-1])});
+{target.result_type} {name}({target.stream_decl}, {gen_signature_with_full_args(metas[-1])});
 void load_{name}();
 void unload_{name}();
     """
 
 
 # generate declarations of kernels with meta-parameter and constant values
-def make_global_decl(meta: KernelLinkerMeta) -> str:
+def make_global_decl(meta: KernelLinkerMeta, target: LinkerTarget = TARGETS["cuda"]) -> str:
     return f"""
-CUresult {meta.orig_kernel_name}_default(CUstream stream, {gen_signature_with_full_args(meta)});
-CUresult {meta.orig_kernel_name}(CUstream stream, {gen_signature_with_full_args(meta)}, int algo_id);
+{target.result_type} {meta.orig_kernel_name}_default({target.stream_decl}, {gen_signature_with_full_args(meta)});
+{target.result_type} {meta.orig_kernel_name}({target.stream_decl}, {gen_signature_with_full_args(meta)}, int algo_id);
 void load_{meta.orig_kernel_name}();
 void unload_{meta.orig_kernel_name}();
     """
 
 
 # generate dispatcher function for kernels with different meta-parameter and constant values
-def make_default_algo_kernel(meta: KernelLinkerMeta) -> str:
-    src = f"CUresult {meta.orig_kernel_name}_default(CUstream stream, {gen_signature_with_full_args(meta)}){{\n"
+def make_default_algo_kernel(meta: KernelLinkerMeta, target: LinkerTarget = TARGETS["cuda"]) -> str:
+    src = f"{target.result_type} {meta.orig_kernel_name}_default({target.stream_decl}, "
+    src += f"{gen_signature_with_full_args(meta)}){{\n"
     src += (f"  return {meta.orig_kernel_name}(stream, {', '.join(meta.arg_names)}, 0);\n")
     src += "}\n"
     return src
 
 
 # generate dispatcher function for kernels with different integer value hints
-def make_kernel_hints_dispatcher(name: str, metas: Sequence[KernelLinkerMeta]) -> str:
+def make_kernel_hints_dispatcher(name: str, metas: Sequence[KernelLinkerMeta],
+                                 target: LinkerTarget = TARGETS["cuda"]) -> str:
     src = f"// launcher for: {name}\n"
     for meta in sorted(metas, key=lambda m: -m.num_specs):
-        src += f"CUresult {meta.orig_kernel_name}_{meta.sig_hash}_{meta.suffix}(CUstream stream, {gen_signature(meta)});\n"
+        src += f"{target.result_type} {meta.orig_kernel_name}_{meta.sig_hash}_{meta.suffix}({target.stream_decl}, "
+        src += f"{gen_signature(meta)});\n"
     src += "\n"
 
-    src += (f"CUresult {name}(CUstream stream, {gen_signature_with_full_args(metas[-1])}){{")
+    src += (f"{target.result_type} {name}({target.stream_decl}, {gen_signature_with_full_args(metas[-1])}){{")
     src += "\n"
     for meta in sorted(metas, key=lambda m: -m.num_specs):
+        # pointers can't be used in arithmetic, e.g. the `void*` arguments of XPU kernels
+        as_int = lambda val, ty: f"(uintptr_t){val}" if ty.endswith("*") else val
         cond_fn = (  #
-            lambda val, hint: f"({val} % {hint} == 0)"  #
+            lambda val, ty, hint: f"({as_int(val, ty)} % {hint} == 0)"  #
             if hint == 16  #
             else f"({val} == {hint})"  #
             if hint == 1  #
             else None)
         conds = " && ".join([  #
-            cond_fn(val, hint)  #
-            for val, hint in zip(meta.arg_names, meta.sizes)  #
+            cond_fn(val, ty, hint)  #
+            for val, ty, hint in zip(meta.arg_names, meta.arg_ctypes, meta.sizes)  #
             if hint is not None
         ])
         src += (f"  if ({conds})\n" if any(meta.sizes) else "if (1)\n"
@@ -183,7 +218,7 @@ def make_kernel_hints_dispatcher(name: str, metas: Sequence[KernelLinkerMeta]) -
         arg_names = [arg for arg, hint in zip(meta.arg_names, meta.sizes) if hint != 1]
         src += f"    return {meta.orig_kernel_name}_{meta.sig_hash}_{meta.suffix}(stream, {', '.join(arg_names)});\n"
     src += "\n"
-    src += "  return CUDA_ERROR_INVALID_VALUE;\n"
+    src += f"  return {target.invalid_value};\n"
     src += "}\n"
 
     for mode in ["load", "unload"]:
@@ -199,8 +234,9 @@ def make_kernel_hints_dispatcher(name: str, metas: Sequence[KernelLinkerMeta]) -
 
 
 # generate dispatcher function for kernels with different meta-parameter and constant values
-def make_kernel_meta_const_dispatcher(meta: KernelLinkerMeta) -> str:
-    src = f"CUresult {meta.orig_kernel_name}(CUstream stream, {gen_signature_with_full_args(meta)}, int algo_id){{\n"
+def make_kernel_meta_const_dispatcher(meta: KernelLinkerMeta, target: LinkerTarget = TARGETS["cuda"]) -> str:
+    src = f"{target.result_type} {meta.orig_kernel_name}({target.stream_decl}, "
+    src += f"{gen_signature_with_full_args(meta)}, int algo_id){{\n"
     src += f"  assert (algo_id < (int)sizeof({meta.orig_kernel_name}_kernels));\n"
     src += f"  return {meta.orig_kernel_name}_kernels[algo_id](stream, {', '.join(meta.arg_names)});\n"
     src += "}\n"
@@ -208,9 +244,10 @@ def make_kernel_meta_const_dispatcher(meta: KernelLinkerMeta) -> str:
 
 
 # generate definition of function pointers of kernel dispatchers based on meta-parameter and constant values
-def make_func_pointers(names: str, meta: KernelLinkerMeta) -> str:
+def make_func_pointers(names: str, meta: KernelLinkerMeta, target: LinkerTarget = TARGETS["cuda"]) -> str:
     # the table of hint dispatchers
-    src = f"typedef CUresult (*kernel_func_t)(CUstream stream, {gen_signature_with_full_args(meta)});\n"
+    src = f"typedef {target.result_type} (*kernel_func_t)({target.stream_decl}, "
+    src += f"{gen_signature_with_full_args(meta)});\n"
     src += f"kernel_func_t {meta.orig_kernel_name}_kernels[] = {{\n"
     for name in names:
         src += f"  {name},\n"
@@ -250,6 +287,8 @@ kernel given the specializations that were compiled.
 
 Example usage:
 python link.py /path/to/headers/*.h -o kernel_name
+
+The target (CUDA or XPU) is detected from the headers unless `--target` is given.
 """
 
 if __name__ == "__main__":
@@ -268,25 +307,31 @@ if __name__ == "__main__":
         default="",
         help="String to prefix kernel dispatcher names",
     )
+    parser.add_argument("--target", "-t", type=str, default=None, choices=list(TARGETS.keys()),
+                        help="Backend the kernels were compiled for, detected from the headers by default")
     args = parser.parse_args()
 
     # metadata
     parser = HeaderParser()
     includes = []
+    target_name = args.target
     for header in args.headers:
         h_path = Path(header)
         h_str = h_path.read_text()
         includes.append(h_path.name)
         parser.extract_linker_meta(h_str)
+        if target_name is None:
+            target_name = "xpu" if "sycl/sycl.hpp" in h_str else "cuda"
+    target = TARGETS[target_name]
 
     # generate headers
-    algo_decls = [make_algo_decls(name, meta) for name, meta in parser.kernels.items()]
+    algo_decls = [make_algo_decls(name, meta, target) for name, meta in parser.kernels.items()]
     meta_lists = [meta for name, meta in parser.kernels.items()]
     meta = meta_lists[0][0]
     get_num_algos_decl = make_get_num_algos_decl(meta)
-    global_decl = make_global_decl(meta)
+    global_decl = make_global_decl(meta, target)
     with args.out.with_suffix(".h").open("w") as fp:
-        out = "#include <cuda.h>\n"
+        out = "".join([f"#include <{include}>\n" for include in target.includes])
         out += "\n".join(algo_decls)
         out += "\n"
         out += get_num_algos_decl
@@ -295,16 +340,16 @@ if __name__ == "__main__":
         fp.write(out)
 
     # generate source
-    defs = [make_kernel_hints_dispatcher(name, meta) for name, meta in parser.kernels.items()]
+    defs = [make_kernel_hints_dispatcher(name, meta, target) for name, meta in parser.kernels.items()]
     names = [name for name in parser.kernels.keys()]
-    func_pointers_def = make_func_pointers(names, meta)
-    meta_const_def = make_kernel_meta_const_dispatcher(meta)
+    func_pointers_def = make_func_pointers(names, meta, target)
+    meta_const_def = make_kernel_meta_const_dispatcher(meta, target)
     load_unload_def = make_kernel_load_def(names, meta)
     get_num_algos_def = make_get_num_algos_def(meta)
-    default_algo_kernel = make_default_algo_kernel(meta)
-    with args.out.with_suffix(".c").open("w") as fp:
+    default_algo_kernel = make_default_algo_kernel(meta, target)
+    with args.out.with_suffix(f".{target.source_ext}").open("w") as fp:
         out = ""
-        out += "#include <cuda.h>\n"
+        out += "".join([f"#include <{include}>\n" for include in target.includes])
         out += "#include <stdint.h>\n"
         out += "#include <assert.h>\n"
         out += "\n"
@@ -0,0 +1,63 @@
+// RUN: triton-opt %s -test-print-integer-range -split-input-file -o %t 2>&1 | FileCheck %s
+
+// CHECK-LABEL: @make_range
+tt.func @make_range() {
+  // CHECK: tt.make_range {{.*}} => [0, 127]
+  %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+  // CHECK-NEXT: arith.constant {{.*}} => [128, 128]
+  %cst = arith.constant dense<128> : tensor<128xi32>
+  // CHECK-NEXT: arith.cmpi {{.*}} => [1, 1]
+  %1 = arith.cmpi slt, %0, %cst : tensor<128xi32>
+  // CHECK-NEXT: arith.constant {{.*}} => [64, 64]
+  %cst_0 = arith.constant dense<64> : tensor<128xi32>
+  // CHECK-NEXT: arith.cmpi {{.*}} => [0, 1]
+  %2 = arith.cmpi slt, %0, %cst_0 : tensor<128xi32>
+  // CHECK-NEXT: arith.addi {{.*}} => [64, 191]
+  %3 = arith.addi %0, %cst_0 : tensor<128xi32>
+  // CHECK-NEXT: tt.expand_dims {{.*}} => [64, 191]
+  %4 = tt.expand_dims %3 {axis = 0 : i32} : tensor<128xi32> -> tensor<1x128xi32>
+  // CHECK-NEXT: arith.extsi {{.*}} => [64, 191]
+  %5 = arith.extsi %4 : tensor<1x128xi32> to tensor<1x128xi64>
+  tt.return
+}
+
+// -----
+
+// CHECK-LABEL: @program_id
+tt.func @program_id(%arg0: i32) {
+  // CHECK: tt.get_program_id {{.*}} => [0, 2147483646]
+  %0 = tt.get_program_id x : i32
+  // CHECK-NEXT: tt.get_num_programs {{.*}} => [1, 2147483647]
+  %1 = tt.get_num_programs x : i32
+  // CHECK-NEXT: arith.constant {{.*}} => [0, 0]
+  %c0_i32 = arith.constant 0 : i32
+  // CHECK-NEXT: arith.cmpi {{.*}} => [1, 1]
+  %2 = arith.cmpi sge, %0, %c0_i32 : i32
+  // CHECK-NEXT: arith.cmpi {{.*}} => [0, 1]
+  %3 = arith.cmpi slt, %0, %1 : i32
+  // CHECK-NEXT: tt.splat {{.*}} => [-2147483648, 2147483647]
+  %4 = tt.splat %arg0 : i32 -> tensor<128xi32>
+  tt.return
+}
+
+// -----
+
+// CHECK-LABEL: @for_induction_var
+tt.func @for_induction_var(%arg0: i32) {
+  %c0_i32 = arith.constant 0 : i32
+  %c32_i32 = arith.constant 32 : i32
+  %c256_i32 = arith.constant 256 : i32
+  // CHECK: arith.addi {{.*}} => [32, 287]
+  // CHECK: index: 0 => [0, 255]
+  scf.for %arg1 = %c0_i32 to %c256_i32 step %c32_i32 : i32 {
+    %0 = arith.addi %arg1, %c32_i32 : i32
+  }
+  // CHECK: arith.muli {{.*}} => [0, 65280]
+  // CHECK: index: 0 => [0, 2147483646]
+  scf.for %arg1 = %c0_i32 to %arg0 step %c32_i32 : i32 {
+    %1 = arith.constant 255 : i32
+    %2 = arith.minsi %arg1, %1 : i32
+    %3 = arith.muli %2, %c256_i32 : i32
+  }
+  tt.return
+}
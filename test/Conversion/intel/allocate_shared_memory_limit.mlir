@@ -0,0 +1,12 @@
+// RUN: triton-opt %s --intel-allocate-shared-memory=max-shared-memory=128 -verify-diagnostics
+
+// COM: Checks that the triton_intel_gpu.alloc buffers which do not fit in the shared local memory of the device are
+// COM: rejected.
+
+// expected-error @+1 {{the triton_intel_gpu.alloc buffers need 256 bytes of shared local memory, more than the 128 bytes of the device}}
+module attributes {"triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  tt.func public @slm_too_large() {
+    %0 = triton_intel_gpu.alloc {size = 256 : i64} : <f16, 3>
+    tt.return
+  }
+}
@@ -241,6 +241,7 @@ module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 8 :
 module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32} {
   // CHECK-LABEL: store_with_cache_attr
   tt.func @store_with_cache_attr(%a_ptr_init : tensor<256x!tt.ptr<f32>, #blocked0>, %cst : tensor<256xi1, #blocked0>, %cst_0 : tensor<256xf32, #blocked0>) {
+    // CHECK-COUNT-2: llvm.store {{.*}} {alignment = 4 : i64, triton_gen.DecorationCacheControlINTEL = #triton_gen.decoration_cache_control<#triton_gen.store_cache_control<0, WriteBack, 1>, #triton_gen.store_cache_control<1, WriteBack, 1>>} : vector<1xi32>, !llvm.ptr<1>
     tt.store %a_ptr_init, %cst_0, %cst evictionPolicy = evict_last cacheModifier = ca : tensor<256x!tt.ptr<f32>, #blocked0>
     tt.return
   }
@@ -248,6 +249,22 @@ module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 :
 
 // -----
 
+#blocked0 = #triton_gpu.blocked<{sizePerThread = [1], threadsPerWarp = [32], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32} {
+  // CHECK-LABEL: load_store_with_cache_attr
+  tt.func @load_store_with_cache_attr(%a_ptr_init : tensor<256x!tt.ptr<f32>, #blocked0>, %cst : tensor<256xi1, #blocked0>, %cst_0 : tensor<256xf32, #blocked0>) {
+    // CHECK-COUNT-2: llvm.load {{.*}} {alignment = 4 : i64, triton_gen.DecorationCacheControlINTEL = #triton_gen.decoration_cache_control<#triton_gen.load_cache_control<0, Uncached, 0>, #triton_gen.load_cache_control<1, Uncached, 0>>} : !llvm.ptr<1> -> i32
+    %1 = tt.load %a_ptr_init, %cst, %cst_0 cacheModifier = cg evictionPolicy = evict_first : tensor<256x!tt.ptr<f32>, #blocked0>
+    // CHECK-COUNT-2: llvm.store {{.*}} {alignment = 4 : i64, triton_gen.DecorationCacheControlINTEL = #triton_gen.decoration_cache_control<#triton_gen.store_cache_control<0, Streaming, 1>, #triton_gen.store_cache_control<1, Uncached, 1>>} : vector<1xi32>, !llvm.ptr<1>
+    tt.store %a_ptr_init, %1, %cst cacheModifier = cs : tensor<256x!tt.ptr<f32>, #blocked0>
+    // CHECK-NOT: triton_gen.DecorationCacheControlINTEL
+    %2 = tt.load %a_ptr_init, %cst, %cst_0 : tensor<256x!tt.ptr<f32>, #blocked0>
+    tt.return
+  }
+}
+
+// -----
+
 #blocked0 = #triton_gpu.blocked<{sizePerThread = [1], threadsPerWarp = [32], warpsPerCTA = [2], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
 module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 2 : i32} {
   // CHECK-LABEL: global_load_store_no_vec
@@ -1687,3 +1704,25 @@ module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 :
     tt.return
   }
 }
+
+// -----
+
+#blocked0 = #triton_gpu.blocked<{sizePerThread = [4], threadsPerWarp = [16], warpsPerCTA = [4], order = [0], CTAsPerCGA = [1], CTASplitNum = [1], CTAOrder = [0]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: fp8_to_fp16_packed
+  tt.func @fp8_to_fp16_packed(%arg0: tensor<256xf8E4M3FNUZ, #blocked0>, %arg1: tensor<256xf8E5M2FNUZ, #blocked0>) {
+    // CHECK: llvm.bitcast %{{.*}} : vector<4xi8> to i32
+    // CHECK: llvm.fmul %{{.*}}, %{{.*}} : vector<2xf16>
+    // CHECK: llvm.icmp "eq" %{{.*}}, %{{.*}} : vector<2xi16>
+    // CHECK: llvm.select %{{.*}}, %{{.*}}, %{{.*}} : vector<2xi1>, vector<2xf16>
+    // CHECK: llvm.fmul %{{.*}}, %{{.*}} : vector<2xf16>
+    // CHECK: llvm.select %{{.*}}, %{{.*}}, %{{.*}} : vector<2xi1>, vector<2xf16>
+    %0 = tt.fp_to_fp %arg0 : tensor<256xf8E4M3FNUZ, #blocked0> -> tensor<256xf16, #blocked0>
+    // CHECK: llvm.bitcast %{{.*}} : vector<4xi8> to i32
+    // CHECK: llvm.sub %{{.*}}, %{{.*}} : vector<2xi16>
+    // CHECK: llvm.icmp "ult" %{{.*}}, %{{.*}} : vector<2xi16>
+    // CHECK: llvm.fpext %{{.*}} : vector<2xf16> to vector<2xf32>
+    %1 = tt.fp_to_fp %arg1 : tensor<256xf8E5M2FNUZ, #blocked0> -> tensor<256xbf16, #blocked0>
+    tt.return
+  }
+}
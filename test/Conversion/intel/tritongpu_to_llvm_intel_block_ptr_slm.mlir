@@ -0,0 +1,30 @@
+// RUN: TRITON_INTEL_ENABLE_BLOCK_PTR=1 triton-opt %s --intel-allocate-shared-memory --convert-triton-intel-gpu-to-llvm | FileCheck %s
+
+// COM: Checks the lowering of a shared local memory allocation and of the block pointer accesses to it.
+
+// CHECK: module attributes {{{.*}}triton_gpu.shared = 256 : i32
+module attributes {"triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: llvm.func spir_kernelcc @slm_round_trip(
+  // CHECK-SAME:                                          [[ARG0:%.*]]: !llvm.ptr<1>, [[SLM:%.*]]: !llvm.ptr<3>)
+  tt.func public @slm_round_trip(%arg0: !tt.ptr<f16>) {
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i64 = arith.constant 1 : i64
+    %c8_i64 = arith.constant 8 : i64
+    %c16_i64 = arith.constant 16 : i64
+    %cst = arith.constant dense<0.000000e+00> : tensor<8x16xf16>
+    // CHECK: llvm.getelementptr [[SLM]][{{.*}}] : (!llvm.ptr<3>, i32) -> !llvm.ptr<3>, i8
+    %0 = triton_intel_gpu.alloc {size = 256 : i64} : <f16, 3>
+    %1 = tt.make_tensor_ptr %0, [%c8_i64, %c16_i64], [%c16_i64, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<8x16xf16>, 3>
+    // CHECK-NOT: LSC2DBlockWrite
+    // CHECK-COUNT-8: llvm.store {{.*}} : i16, !llvm.ptr<3>
+    tt.store %1, %cst : !tt.ptr<tensor<8x16xf16>, 3>
+    gpu.barrier
+    // CHECK-NOT: intel_sub_group_2d_block_read
+    // CHECK-COUNT-8: llvm.load {{.*}} : !llvm.ptr<3> -> i16
+    %2 = tt.load %1 {DotIdx = 0 : i32} : !tt.ptr<tensor<8x16xf16>, 3>
+    %3 = tt.make_tensor_ptr %arg0, [%c8_i64, %c16_i64], [%c16_i64, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<8x16xf16>>
+    // CHECK: LSC2DBlockWrite
+    tt.store %3, %2 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<8x16xf16>>
+    tt.return
+  }
+}
@@ -0,0 +1,80 @@
+// RUN: triton-opt %s -split-input-file -triton-specialize-call-sites | FileCheck %s
+// RUN: triton-opt %s -split-input-file -triton-specialize-call-sites=size-budget=0 | FileCheck %s --check-prefix=NOCLONE
+
+// COM: Checks that a function called with pointers of different divisibility is cloned per call-site divisibility,
+// COM: and that nothing is cloned without budget.
+module {
+  // CHECK-LABEL: tt.func private @addptr_hints(
+  // CHECK-SAME:    tt.divisibility = 16 : i64
+  // CHECK:       tt.func private @[[CLONE:addptr_hints_[0-9]+]](
+  // CHECK-SAME:    tt.divisibility = 8 : i64
+  // NOCLONE-LABEL: tt.func private @addptr_hints(%arg0: !tt.ptr<i32>) {
+  // NOCLONE-NOT:   @addptr_hints_
+  tt.func private @addptr_hints(%arg0: !tt.ptr<i32>) {
+    %c1_i32 = arith.constant 1 : i32
+    %0 = tt.addptr %arg0, %c1_i32 : !tt.ptr<i32>, i32
+    tt.return
+  }
+
+  // CHECK-LABEL: tt.func public @kernel_div16
+  // CHECK:         tt.call @addptr_hints(
+  tt.func public @kernel_div16(%arg0: !tt.ptr<i32> {tt.divisibility = 16 : i32}) {
+    tt.call @addptr_hints(%arg0) : (!tt.ptr<i32>) -> ()
+    tt.return
+  }
+
+  // CHECK-LABEL: tt.func public @kernel_div8
+  // CHECK:         tt.call @[[CLONE]](
+  tt.func public @kernel_div8(%arg0: !tt.ptr<i32> {tt.divisibility = 8 : i32}) {
+    tt.call @addptr_hints(%arg0) : (!tt.ptr<i32>) -> ()
+    tt.return
+  }
+
+  // CHECK-LABEL: tt.func public @kernel_div16_again
+  // CHECK:         tt.call @addptr_hints(
+  tt.func public @kernel_div16_again(%arg0: !tt.ptr<i32> {tt.divisibility = 16 : i32}) {
+    tt.call @addptr_hints(%arg0) : (!tt.ptr<i32>) -> ()
+    tt.return
+  }
+}
+
+// -----
+
+// COM: Checks that the clones of a caller are specialized before their own callees, so that the callee is cloned
+// COM: for the call site of the cloned caller too.
+module {
+  // CHECK-LABEL: tt.func private @inner(
+  // CHECK-SAME:    tt.divisibility = 16 : i64
+  // CHECK:       tt.func private @[[INNER_CLONE:inner_[0-9]+]](
+  // CHECK-SAME:    tt.divisibility = 4 : i64
+  // NOCLONE-NOT: @inner_
+  tt.func private @inner(%arg0: i32) {
+    %c2_i32 = arith.constant 2 : i32
+    %0 = arith.muli %arg0, %c2_i32 : i32
+    tt.return
+  }
+
+  // CHECK-LABEL: tt.func private @outer(
+  // CHECK-SAME:    tt.divisibility = 16 : i64
+  // CHECK:         tt.call @inner(
+  // CHECK:       tt.func private @{{outer_[0-9]+}}(
+  // CHECK-SAME:    tt.divisibility = 4 : i64
+  // CHECK:         tt.call @[[INNER_CLONE]](
+  // NOCLONE-NOT: @outer_
+  tt.func private @outer(%arg0: i32) {
+    tt.call @inner(%arg0) : (i32) -> ()
+    tt.return
+  }
+
+  // CHECK-LABEL: tt.func public @kernel_a
+  tt.func public @kernel_a(%arg0: i32 {tt.divisibility = 4 : i32}) {
+    tt.call @outer(%arg0) : (i32) -> ()
+    tt.return
+  }
+
+  // CHECK-LABEL: tt.func public @kernel_b
+  tt.func public @kernel_b(%arg0: i32 {tt.divisibility = 16 : i32}) {
+    tt.call @outer(%arg0) : (i32) -> ()
+    tt.return
+  }
+}
@@ -234,6 +234,17 @@ llvm.func @triton_gen.sub_group_shuffle() {
 
 // -----
 
+// CHECK: llvm.func spir_funccc @_Z22intel_sub_group_ballotb(i1 {llvm.zeroext}) -> i32 attributes {passthrough = ["convergent"]}
+
+llvm.func @triton_gen.sub_group_ballot(%pred : i1) {
+  // CHECK-LABEL: triton_gen.sub_group_ballot(%arg0: i1)
+  // CHECK: llvm.call spir_funccc @_Z22intel_sub_group_ballotb(%arg0) {{.*}} : (i1) -> i32
+  %0 = triton_gen.sub_group_ballot %pred : i32
+  llvm.return
+}
+
+// -----
+
 // CHECK: llvm.func spir_funccc @_Z36intel_sub_group_i8_i8_matrix_mad_k32Dv8_sDv8_iS0_(vector<8xi16>, vector<8xi32>, vector<8xi32>) -> vector<8xi32> attributes {passthrough = ["convergent"]}
 
 llvm.func @triton_gen.dpas.i8(%c : vector<8xi32>, %a : vector<8xi16>, %b : vector<8xi32>) {
@@ -126,6 +126,13 @@ llvm.func @triton_gen.sub_group_shuffle() {
   llvm.return
 }
 
+llvm.func @triton_gen.sub_group_ballot(%pred : i1) {
+  // CHECK:      llvm.func @triton_gen.sub_group_ballot(%arg0: i1) {
+  // CHECK-NEXT:   %0 = triton_gen.sub_group_ballot %arg0 : i32
+  %0 = triton_gen.sub_group_ballot %pred : i32
+  llvm.return
+}
+
 llvm.func @triton_gen.dpas(%c : vector<8xi32>, %a : vector<8xi16>, %b : vector<8xi32>) {
   // CHECK:      llvm.func @triton_gen.dpas(%arg0: vector<8xi32>, %arg1: vector<8xi16>, %arg2: vector<8xi32>) {
   // CHECK-NEXT:   %0 = triton_gen.dpas %arg0, %arg1, %arg2 {pa = i8, pb = i8, rc = 8} : (vector<8xi32>, vector<8xi16>, vector<8xi32>) -> vector<8xi32>
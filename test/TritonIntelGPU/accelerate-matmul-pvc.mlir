@@ -71,6 +71,120 @@ module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-
 
 // -----
 
+// COM: Flash attention loop: the result of the first dot feeds the second dot, a row-only tiling keeps it in
+// COM: registers and is preferred to tilings reducing the duplication of the K and V loads.
+// CHECK: #[[$DPAS:.+]] = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [8, 1], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [1, 16], warpsPerCTA = [8, 1], order = [1, 0]}>
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 8 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: attention_row_tiling
+  tt.func public @attention_row_tiling(
+    %q: tensor<128x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>,
+    %k_ptr: tensor<64x64x!tt.ptr<f16>, #blocked>,
+    %v_ptr: tensor<64x64x!tt.ptr<f16>, #blocked>) -> tensor<128x64xf32, #blocked> {
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %c8_i32 = arith.constant 8 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<128x64xf32, #blocked>
+    %cst_0 = arith.constant dense<0.000000e+00> : tensor<128x64xf32, #blocked>
+    // CHECK: scf.for
+    // CHECK:   tt.dot {{.*}} -> tensor<128x64xf32, #[[$DPAS]]>
+    // CHECK:   tt.dot {{.*}} -> tensor<128x64xf32, #[[$DPAS]]>
+    %0 = scf.for %arg0 = %c0_i32 to %c8_i32 step %c1_i32 iter_args(%acc = %cst_0) -> (tensor<128x64xf32, #blocked>) : i32 {
+      %k = tt.load %k_ptr : tensor<64x64x!tt.ptr<f16>, #blocked>
+      %k_op = triton_gpu.convert_layout %k : tensor<64x64xf16, #blocked> -> tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>
+      %qk = tt.dot %q, %k_op, %cst {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} :
+        tensor<128x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<128x64xf32, #blocked>
+      %p = math.exp2 %qk : tensor<128x64xf32, #blocked>
+      %p_f16 = arith.truncf %p : tensor<128x64xf32, #blocked> to tensor<128x64xf16, #blocked>
+      %p_op = triton_gpu.convert_layout %p_f16 : tensor<128x64xf16, #blocked> -> tensor<128x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>
+      %v = tt.load %v_ptr : tensor<64x64x!tt.ptr<f16>, #blocked>
+      %v_op = triton_gpu.convert_layout %v : tensor<64x64xf16, #blocked> -> tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>
+      %r = tt.dot %p_op, %v_op, %acc {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} :
+        tensor<128x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<128x64xf32, #blocked>
+      scf.yield %r : tensor<128x64xf32, #blocked>
+    }
+    tt.return %0 : tensor<128x64xf32, #blocked>
+  }
+}
+
+// -----
+
+// COM: Flash attention loop with a large head dimension: halving the duplication of the K and V loads outweighs
+// COM: exchanging the (small) result of the first dot through SLM.
+// CHECK: #[[$DPAS:.+]] = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 2], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [1, 16], warpsPerCTA = [8, 1], order = [1, 0]}>
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 8 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: attention_large_head_dim
+  tt.func public @attention_large_head_dim(
+    %q: tensor<64x256xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>,
+    %k_ptr: tensor<256x32x!tt.ptr<f16>, #blocked>,
+    %v_ptr: tensor<32x256x!tt.ptr<f16>, #blocked>) -> tensor<64x256xf32, #blocked> {
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %c8_i32 = arith.constant 8 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x32xf32, #blocked>
+    %cst_0 = arith.constant dense<0.000000e+00> : tensor<64x256xf32, #blocked>
+    // CHECK: scf.for
+    // CHECK:   tt.dot {{.*}} -> tensor<64x32xf32, #[[$DPAS]]>
+    // CHECK:   tt.dot {{.*}} -> tensor<64x256xf32, #[[$DPAS]]>
+    %0 = scf.for %arg0 = %c0_i32 to %c8_i32 step %c1_i32 iter_args(%acc = %cst_0) -> (tensor<64x256xf32, #blocked>) : i32 {
+      %k = tt.load %k_ptr : tensor<256x32x!tt.ptr<f16>, #blocked>
+      %k_op = triton_gpu.convert_layout %k : tensor<256x32xf16, #blocked> -> tensor<256x32xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>
+      %qk = tt.dot %q, %k_op, %cst {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} :
+        tensor<64x256xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<256x32xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x32xf32, #blocked>
+      %p = math.exp2 %qk : tensor<64x32xf32, #blocked>
+      %p_f16 = arith.truncf %p : tensor<64x32xf32, #blocked> to tensor<64x32xf16, #blocked>
+      %p_op = triton_gpu.convert_layout %p_f16 : tensor<64x32xf16, #blocked> -> tensor<64x32xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>
+      %v = tt.load %v_ptr : tensor<32x256x!tt.ptr<f16>, #blocked>
+      %v_op = triton_gpu.convert_layout %v : tensor<32x256xf16, #blocked> -> tensor<32x256xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>
+      %r = tt.dot %p_op, %v_op, %acc {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} :
+        tensor<64x32xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<32x256xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x256xf32, #blocked>
+      scf.yield %r : tensor<64x256xf32, #blocked>
+    }
+    tt.return %0 : tensor<64x256xf32, #blocked>
+  }
+}
+
+// -----
+
+// COM: Flash attention loop with too few rows to give a DPAS tile to each warp with a row-only tiling: the warps
+// COM: are tiled over the columns as well.
+// CHECK: #[[$DPAS:.+]] = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 4], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 4], threadsPerWarp = [1, 16], warpsPerCTA = [16, 1], order = [1, 0]}>
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 16 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: attention_small_block_m
+  tt.func public @attention_small_block_m(
+    %q: tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>,
+    %k_ptr: tensor<64x64x!tt.ptr<f16>, #blocked>,
+    %v_ptr: tensor<64x64x!tt.ptr<f16>, #blocked>) -> tensor<64x64xf32, #blocked> {
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %c8_i32 = arith.constant 8 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x64xf32, #blocked>
+    %cst_0 = arith.constant dense<0.000000e+00> : tensor<64x64xf32, #blocked>
+    // CHECK: scf.for
+    // CHECK:   tt.dot {{.*}} -> tensor<64x64xf32, #[[$DPAS]]>
+    // CHECK:   tt.dot {{.*}} -> tensor<64x64xf32, #[[$DPAS]]>
+    %0 = scf.for %arg0 = %c0_i32 to %c8_i32 step %c1_i32 iter_args(%acc = %cst_0) -> (tensor<64x64xf32, #blocked>) : i32 {
+      %k = tt.load %k_ptr : tensor<64x64x!tt.ptr<f16>, #blocked>
+      %k_op = triton_gpu.convert_layout %k : tensor<64x64xf16, #blocked> -> tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>
+      %qk = tt.dot %q, %k_op, %cst {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} :
+        tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x64xf32, #blocked>
+      %p = math.exp2 %qk : tensor<64x64xf32, #blocked>
+      %p_f16 = arith.truncf %p : tensor<64x64xf32, #blocked> to tensor<64x64xf16, #blocked>
+      %p_op = triton_gpu.convert_layout %p_f16 : tensor<64x64xf16, #blocked> -> tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>
+      %v = tt.load %v_ptr : tensor<64x64x!tt.ptr<f16>, #blocked>
+      %v_op = triton_gpu.convert_layout %v : tensor<64x64xf16, #blocked> -> tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>
+      %r = tt.dot %p_op, %v_op, %acc {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} :
+        tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x64xf32, #blocked>
+      scf.yield %r : tensor<64x64xf32, #blocked>
+    }
+    tt.return %0 : tensor<64x64xf32, #blocked>
+  }
+}
+
+// -----
+
 // CHECK-NOT: dpas
 #blocked = #triton_gpu.blocked<{sizePerThread = [8, 8], threadsPerWarp = [4, 2], warpsPerCTA = [4, 1], order = [1, 0]}>
 #blocked1 = #triton_gpu.blocked<{sizePerThread = [8, 8], threadsPerWarp = [1, 8], warpsPerCTA = [4, 1], order = [1, 0]}>
@@ -131,3 +245,24 @@ module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-
     tt.return %r : tensor<64x128xf32, #blocked1>
   }
 }
+
+// -----
+
+// CHECK: #[[$DPAS:.+]] = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 1], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#blocked = #triton_gpu.blocked<{sizePerThread = [4, 4], threadsPerWarp = [1, 16], warpsPerCTA = [4, 1], order = [1, 0]}>
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: fp8_dot
+  tt.func public @fp8_dot(
+    %arg0: tensor<64x32xf8E4M3FNUZ, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>>,
+    %arg1: tensor<32x64xf8E5M2, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>>) -> tensor<64x64xf32, #blocked> {
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x64xf32, #blocked>
+    // CHECK: [[A:%.*]] = triton_gpu.convert_layout %arg0 : {{.*}} -> tensor<64x32xf8E4M3FNUZ, #triton_gpu.dot_op<{opIdx = 0, parent = #[[$DPAS]], kWidth = 2}>>
+    // CHECK: [[B:%.*]] = triton_gpu.convert_layout %arg1 : {{.*}} -> tensor<32x64xf8E5M2, #triton_gpu.dot_op<{opIdx = 1, parent = #[[$DPAS]], kWidth = 2}>>
+    // CHECK: [[A_F16:%.*]] = tt.fp_to_fp [[A]] : tensor<64x32xf8E4M3FNUZ, #triton_gpu.dot_op<{opIdx = 0, parent = #[[$DPAS]], kWidth = 2}>> -> tensor<64x32xf16, #triton_gpu.dot_op<{opIdx = 0, parent = #[[$DPAS]], kWidth = 2}>>
+    // CHECK: [[B_F16:%.*]] = tt.fp_to_fp [[B]] : tensor<32x64xf8E5M2, #triton_gpu.dot_op<{opIdx = 1, parent = #[[$DPAS]], kWidth = 2}>> -> tensor<32x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #[[$DPAS]], kWidth = 2}>>
+    // CHECK: tt.dot [[A_F16]], [[B_F16]], {{.*}} -> tensor<64x64xf32, #[[$DPAS]]>
+    %0 = tt.dot %arg0, %arg1, %cst {inputPrecision = 0 : i32, maxNumImpreciseAcc = 0 : i32} :
+      tensor<64x32xf8E4M3FNUZ, #triton_gpu.dot_op<{opIdx = 0, parent = #blocked}>> * tensor<32x64xf8E5M2, #triton_gpu.dot_op<{opIdx = 1, parent = #blocked}>> -> tensor<64x64xf32, #blocked>
+    tt.return %0 : tensor<64x64xf32, #blocked>
+  }
+}
@@ -263,3 +263,47 @@ module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 :
     tt.return
   }
 }
+
+// -----
+
+// COM: Case 5:
+// COM: Checks that the 1x256 scale of an int8 operand B is never converted to
+// COM: a dot operand layout: the shared memory to DPAS operand lowering expects
+// COM: whole operand tiles.
+// CHECK-NOT: tensor<1x256xf16, #triton_gpu.dot_op
+// CHECK-NOT: tensor<256xf16, #triton_gpu.slice<{dim = 0, parent = #triton_gpu.dot_op
+#blocked = #triton_gpu.blocked<{sizePerThread = [1, 1], threadsPerWarp = [1, 16], warpsPerCTA = [2, 2], order = [1, 0]}>
+#blocked1 = #triton_gpu.blocked<{sizePerThread = [1, 1], threadsPerWarp = [1, 16], warpsPerCTA = [1, 4], order = [1, 0]}>
+#dpas = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [1, 4], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#dot0 = #triton_gpu.dot_op<{opIdx = 0, parent = #dpas, kWidth=2}>
+#dot1 = #triton_gpu.dot_op<{opIdx = 1, parent = #dpas, kWidth=2}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 4 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  tt.func public @matmul_kernel_dequantize_b(%arg0: !tt.ptr<f16>, %arg1: !tt.ptr<i8>, %arg2: !tt.ptr<f16>, %arg3: i32) -> tensor<64x256xf32, #dpas> {
+    %c1_i64 = arith.constant 1 : i64
+    %c0_i32 = arith.constant 0 : i32
+    %c0_i64 = arith.constant 0 : i64
+    %c32_i32 = arith.constant 32 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x256xf32, #dpas>
+    %0 = tt.make_range {end = 256 : i32, start = 0 : i32} : tensor<256xi32, #triton_gpu.slice<{dim = 0, parent = #blocked1}>>
+    %1 = tt.splat %arg2 : !tt.ptr<f16> -> tensor<256x!tt.ptr<f16>, #triton_gpu.slice<{dim = 0, parent = #blocked1}>>
+    %2 = tt.addptr %1, %0 : tensor<256x!tt.ptr<f16>, #triton_gpu.slice<{dim = 0, parent = #blocked1}>>, tensor<256xi32, #triton_gpu.slice<{dim = 0, parent = #blocked1}>>
+    %3 = tt.load %2 : tensor<256x!tt.ptr<f16>, #triton_gpu.slice<{dim = 0, parent = #blocked1}>>
+    %4 = tt.expand_dims %3 {axis = 0 : i32} : tensor<256xf16, #triton_gpu.slice<{dim = 0, parent = #blocked1}>> -> tensor<1x256xf16, #blocked1>
+    %18 = tt.make_tensor_ptr %arg0, [%c0_i64, %c0_i64], [%c0_i64, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x32xf16, #blocked>>
+    %22 = tt.make_tensor_ptr %arg1, [%c0_i64, %c0_i64], [%c0_i64, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<32x256xi8, #blocked1>>
+    %23:3 = scf.for %arg9 = %c0_i32 to %arg3 step %c32_i32 iter_args(%arg10 = %cst, %arg11 = %18, %arg12 = %22) -> (tensor<64x256xf32, #dpas>, !tt.ptr<tensor<64x32xf16, #blocked>>, !tt.ptr<tensor<32x256xi8, #blocked1>>)  : i32 {
+      %28 = tt.load %arg11 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x32xf16, #blocked>>
+      %29 = tt.load %arg12 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<32x256xi8, #blocked1>>
+      %30 = arith.sitofp %29 : tensor<32x256xi8, #blocked1> to tensor<32x256xf16, #blocked1>
+      %31 = tt.broadcast %4 : tensor<1x256xf16, #blocked1> -> tensor<32x256xf16, #blocked1>
+      %32 = arith.mulf %30, %31 : tensor<32x256xf16, #blocked1>
+      %33 = triton_gpu.convert_layout %28 : tensor<64x32xf16, #blocked> -> tensor<64x32xf16, #dot0>
+      %34 = triton_gpu.convert_layout %32 : tensor<32x256xf16, #blocked1> -> tensor<32x256xf16, #dot1>
+      %35 = tt.dot %33, %34, %arg10, inputPrecision = tf32 : tensor<64x32xf16, #dot0> * tensor<32x256xf16, #dot1> -> tensor<64x256xf32, #dpas>
+      %36 = tt.advance %arg11, [%c0_i32, %c32_i32] : <tensor<64x32xf16, #blocked>>
+      %37 = tt.advance %arg12, [%c32_i32, %c0_i32] : <tensor<32x256xi8, #blocked1>>
+      scf.yield %35, %36, %37 : tensor<64x256xf32, #dpas>, !tt.ptr<tensor<64x32xf16, #blocked>>, !tt.ptr<tensor<32x256xi8, #blocked1>>
+    }
+    tt.return %23#0 : tensor<64x256xf32, #dpas>
+  }
+}
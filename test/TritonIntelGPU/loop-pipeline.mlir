@@ -185,3 +185,69 @@ module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-
     tt.return
   }
 }
+
+// -----
+
+// COM: Test that loops yielding a loop carried value as is (i.e. with a dependency distance greater than one) are pipelined.
+#dpas = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 8], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#dot0 = #triton_gpu.dot_op<{opIdx = 0, parent = #dpas, kWidth=2}>
+#dot1 = #triton_gpu.dot_op<{opIdx = 1, parent = #dpas, kWidth=2}>
+
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 32 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: tt.func public @rotating_accumulators
+  tt.func public @rotating_accumulators(%arg0: !tt.ptr<tensor<128x64xf16, #dot0>>, %arg1: !tt.ptr<tensor<64x256xf16, #dot1>>, %arg2: i32) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<128x256xf32, #dpas>
+    %c64_i32 = arith.constant 64 : i32
+    %c0_i32 = arith.constant 0 : i32
+    // CHECK:      triton_intel_gpu.prefetch
+    // CHECK:      scf.for
+    // CHECK:        triton_intel_gpu.prefetch
+    // CHECK:        tt.dot
+    // COM: The trivial select materializing the loop carried value is left for canonicalization to fold.
+    // CHECK:        arith.select %true
+    // CHECK:        scf.yield
+    %0:4 = scf.for %arg3 = %c0_i32 to %arg2 step %c64_i32 iter_args(%arg4 = %cst, %arg5 = %cst, %arg6 = %arg0, %arg7 = %arg1) -> (tensor<128x256xf32, #dpas>, tensor<128x256xf32, #dpas>, !tt.ptr<tensor<128x64xf16, #dot0>>, !tt.ptr<tensor<64x256xf16, #dot1>>)  : i32 {
+      %1 = tt.load %arg6 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<128x64xf16, #dot0>>
+      %2 = tt.load %arg7 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x256xf16, #dot1>>
+      %3 = tt.dot %1, %2, %arg4, inputPrecision = tf32 : tensor<128x64xf16, #dot0> * tensor<64x256xf16, #dot1> -> tensor<128x256xf32, #dpas>
+      %4 = tt.advance %arg6, [%c0_i32, %c64_i32] : <tensor<128x64xf16, #dot0>>
+      %5 = tt.advance %arg7, [%c64_i32, %c0_i32] : <tensor<64x256xf16, #dot1>>
+      scf.yield %arg5, %3, %4, %5 : tensor<128x256xf32, #dpas>, tensor<128x256xf32, #dpas>, !tt.ptr<tensor<128x64xf16, #dot0>>, !tt.ptr<tensor<64x256xf16, #dot1>>
+    }
+    tt.return
+  }
+}
+
+// -----
+
+// COM: Test that the inner loop of a loop nest is pipelined, while the outer loop is not.
+#dpas = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 8], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#dot0 = #triton_gpu.dot_op<{opIdx = 0, parent = #dpas, kWidth=2}>
+#dot1 = #triton_gpu.dot_op<{opIdx = 1, parent = #dpas, kWidth=2}>
+
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 32 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: tt.func public @nested_loops
+  tt.func public @nested_loops(%arg0: !tt.ptr<tensor<128x64xf16, #dot0>>, %arg1: !tt.ptr<tensor<64x256xf16, #dot1>>, %arg2: i32, %arg3: i32) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<128x256xf32, #dpas>
+    %c64_i32 = arith.constant 64 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %c0_i32 = arith.constant 0 : i32
+    // CHECK:          scf.for
+    // CHECK-COUNT-4:    triton_intel_gpu.prefetch
+    // CHECK:            scf.for
+    // CHECK-COUNT-2:      triton_intel_gpu.prefetch
+    // CHECK:              tt.dot
+    %0 = scf.for %arg4 = %c0_i32 to %arg2 step %c1_i32 iter_args(%arg5 = %cst) -> (tensor<128x256xf32, #dpas>)  : i32 {
+      %1:3 = scf.for %arg6 = %c0_i32 to %arg3 step %c64_i32 iter_args(%arg7 = %arg5, %arg8 = %arg0, %arg9 = %arg1) -> (tensor<128x256xf32, #dpas>, !tt.ptr<tensor<128x64xf16, #dot0>>, !tt.ptr<tensor<64x256xf16, #dot1>>)  : i32 {
+        %2 = tt.load %arg8 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<128x64xf16, #dot0>>
+        %3 = tt.load %arg9 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x256xf16, #dot1>>
+        %4 = tt.dot %2, %3, %arg7, inputPrecision = tf32 : tensor<128x64xf16, #dot0> * tensor<64x256xf16, #dot1> -> tensor<128x256xf32, #dpas>
+        %5 = tt.advance %arg8, [%c0_i32, %c64_i32] : <tensor<128x64xf16, #dot0>>
+        %6 = tt.advance %arg9, [%c64_i32, %c0_i32] : <tensor<64x256xf16, #dot1>>
+        scf.yield %4, %5, %6 : tensor<128x256xf32, #dpas>, !tt.ptr<tensor<128x64xf16, #dot0>>, !tt.ptr<tensor<64x256xf16, #dot1>>
+      }
+      scf.yield %1#0 : tensor<128x256xf32, #dpas>
+    }
+    tt.return
+  }
+}
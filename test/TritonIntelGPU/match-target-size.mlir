@@ -279,3 +279,26 @@ tt.func public @matmul_kernel_with_block_pointers_tf32(%arg0: !tt.ptr<f32> {tt.d
   tt.store %tptr_c, %35#0 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<8x32xf32, #warp>>
   tt.return
 }
+
+// -----
+
+// COM: Test that dot operands are read with the 2D block shapes requiring the fewest reads.
+
+// CHECK-LABEL: @dot_operands_block_shapes
+#warp = #triton_intel_gpu.warp<{sizePerThread = [64, 64], threadsPerWarp = [1, 1], order = [1, 0]}>
+tt.func public @dot_operands_block_shapes(%arg0: !tt.ptr<i8>, %arg1: !tt.ptr<f16>) {
+  %c0_i32 = arith.constant 0 : i32
+  %c1_i64 = arith.constant 1 : i64
+  %c64_i64 = arith.constant 64 : i64
+  // COM: int8 A operand: 2 blocks of 32x32 side by side per read.
+  // CHECK-COUNT-2: tt.load {{.*}} {DotIdx = 0 : i32} : !tt.ptr<tensor<32x64xi8>>
+  // CHECK-NOT:     tt.load {{.*}} {DotIdx = 0 : i32}
+  // COM: fp16 B operand: 2 blocks of 32x16 side by side per (VNNI transformed) read.
+  // CHECK-COUNT-4: tt.load {{.*}} {DotIdx = 1 : i32} : !tt.ptr<tensor<32x32xf16>>
+  // CHECK-NOT:     tt.load {{.*}} {DotIdx = 1 : i32}
+  %tptr_a = tt.make_tensor_ptr %arg0, [%c64_i64, %c64_i64], [%c64_i64, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x64xi8, #triton_gpu.dot_op<{opIdx = 0, parent = #warp}>>>
+  %tptr_b = tt.make_tensor_ptr %arg1, [%c64_i64, %c64_i64], [%c64_i64, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #warp}>>>
+  %a = tt.load %tptr_a : !tt.ptr<tensor<64x64xi8, #triton_gpu.dot_op<{opIdx = 0, parent = #warp}>>>
+  %b = tt.load %tptr_b : !tt.ptr<tensor<64x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #warp}>>>
+  tt.return
+}
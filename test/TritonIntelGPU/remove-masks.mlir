@@ -0,0 +1,104 @@
+// RUN: triton-opt %s -split-input-file -tritonintelgpu-remove-masks | FileCheck %s
+
+// COM: Checks that the masks known to be all true from the integer range analysis are removed.
+module {
+  // CHECK-LABEL: tt.func public @fold_masks
+  // CHECK-NOT:     arith.cmpi
+  // CHECK:         [[LOAD:%.*]] = tt.load %{{.*}} : tensor<128x!tt.ptr<f32>>
+  // CHECK:         tt.store %{{.*}}, [[LOAD]] : tensor<128x!tt.ptr<f32>>
+  tt.func public @fold_masks(%arg0: !tt.ptr<f32>) {
+    %cst = arith.constant dense<128> : tensor<128xi32>
+    %cst_0 = arith.constant dense<0.000000e+00> : tensor<128xf32>
+    %0 = tt.make_range {end = 128 : i32, start = 0 : i32} : tensor<128xi32>
+    %1 = arith.cmpi slt, %0, %cst : tensor<128xi32>
+    %2 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<128x!tt.ptr<f32>>
+    %3 = tt.addptr %2, %0 : tensor<128x!tt.ptr<f32>>, tensor<128xi32>
+    %4 = tt.load %3, %1, %cst_0 : tensor<128x!tt.ptr<f32>>
+    tt.store %3, %4, %1 : tensor<128x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// -----
+
+// COM: Checks that a loop whose mask only fails in its last iterations is split into a mask-free steady state loop
+// COM: and a masked tail loop. The loop runs ceildiv(N, 32) iterations, so the offsets cannot wrap around.
+module {
+  // CHECK-LABEL: tt.func public @split_loop
+  // CHECK-SAME:    ([[PTR:%.*]]: !tt.ptr<f32>, [[K:%.*]]: i32, [[N:%.*]]: i32)
+  // CHECK:         [[UB:%.*]] = arith.divsi
+  // CHECK:         arith.extsi [[K]] : i32 to i64
+  // CHECK:         arith.floordivsi
+  // CHECK:         [[SPLIT:%.*]] = arith.minsi
+  // CHECK:         [[SPLIT_I32:%.*]] = arith.trunci [[SPLIT]] : i64 to i32
+  // CHECK:         [[STEADY:%.*]] = scf.for {{.*}} to [[SPLIT_I32]] step {{.*}} -> (tensor<32xf32>)
+  // CHECK-NOT:       arith.cmpi
+  // CHECK:           tt.load %{{.*}} : tensor<32x!tt.ptr<f32>>
+  // CHECK:           scf.yield
+  // CHECK:         }
+  // CHECK:         [[TAIL:%.*]] = scf.for {{.*}} = [[SPLIT_I32]] to [[UB]] step {{.*}} iter_args({{.*}} = [[STEADY]]) -> (tensor<32xf32>)
+  // CHECK:           [[MASK:%.*]] = arith.cmpi slt
+  // CHECK:           tt.load %{{.*}}, [[MASK]], %{{.*}} : tensor<32x!tt.ptr<f32>>
+  // CHECK:           scf.yield
+  // CHECK:         }
+  // CHECK:         tt.store %{{.*}}, [[TAIL]] : tensor<32x!tt.ptr<f32>>
+  tt.func public @split_loop(%arg0: !tt.ptr<f32>, %arg1: i32, %arg2: i32) {
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %c31_i32 = arith.constant 31 : i32
+    %c32_i32 = arith.constant 32 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<32xf32>
+    %0 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+    %1 = tt.splat %arg1 : i32 -> tensor<32xi32>
+    %2 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<32x!tt.ptr<f32>>
+    %n = arith.addi %arg2, %c31_i32 : i32
+    %ub = arith.divsi %n, %c32_i32 : i32
+    %3 = scf.for %arg3 = %c0_i32 to %ub step %c1_i32 iter_args(%arg4 = %cst) -> (tensor<32xf32>)  : i32 {
+      %4 = arith.muli %arg3, %c32_i32 : i32
+      %5 = tt.splat %4 : i32 -> tensor<32xi32>
+      %6 = arith.addi %5, %0 : tensor<32xi32>
+      %7 = arith.cmpi slt, %6, %1 : tensor<32xi32>
+      %8 = tt.addptr %2, %6 : tensor<32x!tt.ptr<f32>>, tensor<32xi32>
+      %9 = tt.load %8, %7, %cst : tensor<32x!tt.ptr<f32>>
+      %10 = arith.addf %arg4, %9 : tensor<32xf32>
+      scf.yield %10 : tensor<32xf32>
+    }
+    %11 = tt.addptr %2, %0 : tensor<32x!tt.ptr<f32>>, tensor<32xi32>
+    tt.store %11, %3 : tensor<32x!tt.ptr<f32>>
+    tt.return
+  }
+}
+
+// -----
+
+// COM: Checks that a loop is not split when its i32 offsets may wrap around: with an unknown upper bound, %iv * 32
+// COM: overflows for large %iv and the mask must be kept.
+module {
+  // CHECK-LABEL: tt.func public @keep_wrapping_mask
+  // CHECK:         scf.for
+  // CHECK:           [[MASK:%.*]] = arith.cmpi slt
+  // CHECK:           tt.load %{{.*}}, [[MASK]], %{{.*}} : tensor<32x!tt.ptr<f32>>
+  // CHECK-NOT:     scf.for
+  tt.func public @keep_wrapping_mask(%arg0: !tt.ptr<f32>, %arg1: i32, %arg2: i32) {
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i32 = arith.constant 1 : i32
+    %c32_i32 = arith.constant 32 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<32xf32>
+    %0 = tt.make_range {end = 32 : i32, start = 0 : i32} : tensor<32xi32>
+    %1 = tt.splat %arg1 : i32 -> tensor<32xi32>
+    %2 = tt.splat %arg0 : !tt.ptr<f32> -> tensor<32x!tt.ptr<f32>>
+    %3 = scf.for %arg3 = %c0_i32 to %arg2 step %c1_i32 iter_args(%arg4 = %cst) -> (tensor<32xf32>)  : i32 {
+      %4 = arith.muli %arg3, %c32_i32 : i32
+      %5 = tt.splat %4 : i32 -> tensor<32xi32>
+      %6 = arith.addi %5, %0 : tensor<32xi32>
+      %7 = arith.cmpi slt, %6, %1 : tensor<32xi32>
+      %8 = tt.addptr %2, %6 : tensor<32x!tt.ptr<f32>>, tensor<32xi32>
+      %9 = tt.load %8, %7, %cst : tensor<32x!tt.ptr<f32>>
+      %10 = arith.addf %arg4, %9 : tensor<32xf32>
+      scf.yield %10 : tensor<32xf32>
+    }
+    %11 = tt.addptr %2, %0 : tensor<32x!tt.ptr<f32>>, tensor<32xi32>
+    tt.store %11, %3 : tensor<32x!tt.ptr<f32>>
+    tt.return
+  }
+}
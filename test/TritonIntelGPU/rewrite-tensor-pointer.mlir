@@ -204,3 +204,100 @@ module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC"} {
     tt.return
   }
 }
+
+// -----
+
+// COM: Case 4:
+// COM: Check that column-major block pointers (order = [0, 1]) with 16 bit elements are not rewritten, while
+// COM: column-major block pointers with 32 bit elements are rewritten to use a legacy pointer.
+#dpas = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 2], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#dot1 = #triton_gpu.dot_op<{opIdx = 1, parent = #dpas, kWidth=2}>
+#dpas1 = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 1, threadsPerWarp = 16, warpsPerCTA = [4, 2], A = [8, 8], B = [8, 16], C = [8, 16]}>
+#dot2 = #triton_gpu.dot_op<{opIdx = 1, parent = #dpas1, kWidth=1}>
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 8 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  tt.func public @column_major_kernel(%arg0: !tt.ptr<f16> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f32> {tt.divisibility = 16 : i32},
+                                      %arg2: i32 {tt.divisibility = 16 : i32}, %arg3: i32 {tt.divisibility = 16 : i32}, %arg4: i32 {tt.divisibility = 16 : i32}) {
+    // CHECK: @column_major_kernel
+    %c0_i32 = arith.constant 0 : i32
+    %c32_i32 = arith.constant 32 : i32
+    %c64_i32 = arith.constant 64 : i32
+    %c1_i64 = arith.constant 1 : i64
+    %0 = tt.get_program_id x : i32
+    %1 = arith.muli %0, %c64_i32 : i32
+    %2 = arith.extsi %arg2 : i32 to i64
+    %3 = arith.extsi %arg3 : i32 to i64
+    %4 = arith.extsi %arg4 : i32 to i64
+    // CHECK: tt.make_tensor_ptr {{.*}} {order = array<i32: 0, 1>} : <tensor<32x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #{{.*}}, kWidth = 2}>>>
+    %5 = tt.make_tensor_ptr %arg0, [%2, %3], [%c1_i64, %4], [%c0_i32, %1] {order = array<i32: 0, 1>} : <tensor<32x64xf16, #dot1>>
+    // CHECK: tt.advance {{.*}} : <tensor<32x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #{{.*}}, kWidth = 2}>>>
+    %6 = tt.advance %5, [%c32_i32, %c0_i32] : <tensor<32x64xf16, #dot1>>
+    // CHECK: tt.load {{.*}} : !tt.ptr<tensor<32x64xf16, #triton_gpu.dot_op<{opIdx = 1, parent = #{{.*}}, kWidth = 2}>>>
+    %7 = tt.load %6 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<32x64xf16, #dot1>>
+    // CHECK-NOT: tt.make_tensor_ptr
+    %8 = tt.make_tensor_ptr %arg1, [%2, %3], [%c1_i64, %4], [%c0_i32, %1] {order = array<i32: 0, 1>} : <tensor<32x64xf32, #dot2>>
+    // CHECK: tt.load {{.*}}, {{.*}} : tensor<32x64x!tt.ptr<f32>, #triton_gpu.dot_op<{opIdx = 1, parent = #{{.*}}, kWidth = 1}>>
+    %9 = tt.load %8 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<32x64xf32, #dot2>>
+    tt.return
+  }
+}
+
+// -----
+
+// COM: Case 5:
+// COM: Check that block pointers with a DPAS layout only used by stores are not rewritten, while block pointers
+// COM: with a DPAS layout that are also loaded are rewritten to use a legacy pointer.
+#dpas = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 2], A = [8, 16], B = [16, 16], C = [8, 16]}>
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 8 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  tt.func public @store_kernel(%arg0: !tt.ptr<f16> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<f16> {tt.divisibility = 16 : i32},
+                               %arg2: i32 {tt.divisibility = 16 : i32}, %arg3: i32 {tt.divisibility = 16 : i32}, %arg4: i32 {tt.divisibility = 16 : i32}) {
+    // CHECK: @store_kernel
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i64 = arith.constant 1 : i64
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x64xf16, #dpas>
+    %0 = arith.extsi %arg2 : i32 to i64
+    %1 = arith.extsi %arg3 : i32 to i64
+    %2 = arith.extsi %arg4 : i32 to i64
+    // CHECK: tt.make_tensor_ptr {{.*}} {order = array<i32: 1, 0>} : <tensor<64x64xf16, #{{.*}}>>
+    %3 = tt.make_tensor_ptr %arg0, [%0, %1], [%2, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x64xf16, #dpas>>
+    // CHECK: tt.store {{.*}}, {{.*}} {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x64xf16, #{{.*}}>>
+    tt.store %3, %cst {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x64xf16, #dpas>>
+    // CHECK-NOT: tt.make_tensor_ptr
+    %4 = tt.make_tensor_ptr %arg1, [%0, %1], [%2, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x64xf16, #dpas>>
+    %5 = tt.load %4 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x64xf16, #dpas>>
+    // CHECK: tt.store {{.*}}, {{.*}}, {{.*}} : tensor<64x64x!tt.ptr<f16>, #{{.*}}>
+    tt.store %4, %5 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x64xf16, #dpas>>
+    tt.return
+  }
+}
+
+// -----
+
+// COM: Case 6:
+// COM: Check that 8 bit block pointers with the layout of operand B of a 16 bit DPAS (e.g. dequantized weights) are
+// COM: not rewritten, while 8 bit block pointers with the layout of operand A of a 16 bit DPAS are rewritten.
+#dpas = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 2], A = [8, 16], B = [16, 16], C = [8, 16]}>
+#dot0 = #triton_gpu.dot_op<{opIdx = 0, parent = #dpas, kWidth = 2}>
+#dot1 = #triton_gpu.dot_op<{opIdx = 1, parent = #dpas, kWidth = 2}>
+module attributes {"triton_gpu.target" = "xpu:DEVICE_ARCH.PVC", "triton_gpu.num-warps" = 8 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  tt.func public @dequantize_kernel(%arg0: !tt.ptr<i8> {tt.divisibility = 16 : i32}, %arg1: !tt.ptr<i8> {tt.divisibility = 16 : i32},
+                                    %arg2: i32 {tt.divisibility = 16 : i32}, %arg3: i32 {tt.divisibility = 16 : i32}) -> tensor<64x64xf32, #dpas> {
+    // CHECK: @dequantize_kernel
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i64 = arith.constant 1 : i64
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x64xf32, #dpas>
+    %0 = arith.extsi %arg2 : i32 to i64
+    %1 = arith.extsi %arg3 : i32 to i64
+    // CHECK-NOT: tt.make_tensor_ptr {{.*}} : <tensor<64x32xi8, #{{.*}}>>
+    %2 = tt.make_tensor_ptr %arg0, [%0, %1], [%1, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x32xi8, #dot0>>
+    // CHECK: tt.make_tensor_ptr {{.*}} {order = array<i32: 1, 0>} : <tensor<32x64xi8, #{{.*}}>>
+    %3 = tt.make_tensor_ptr %arg1, [%1, %0], [%0, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<32x64xi8, #dot1>>
+    // CHECK: tt.load {{.*}}, {{.*}}, {{.*}} : tensor<64x32x!tt.ptr<i8>, #{{.*}}>
+    %4 = tt.load %2 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x32xi8, #dot0>>
+    // CHECK: tt.load {{.*}} {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<32x64xi8, #{{.*}}>>
+    %5 = tt.load %3 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<32x64xi8, #dot1>>
+    %6 = arith.sitofp %4 : tensor<64x32xi8, #dot0> to tensor<64x32xf16, #dot0>
+    %7 = arith.sitofp %5 : tensor<32x64xi8, #dot1> to tensor<32x64xf16, #dot1>
+    %8 = tt.dot %6, %7, %cst, inputPrecision = tf32 : tensor<64x32xf16, #dot0> * tensor<32x64xf16, #dot1> -> tensor<64x64xf32, #dpas>
+    tt.return %8 : tensor<64x64xf32, #dpas>
+  }
+}
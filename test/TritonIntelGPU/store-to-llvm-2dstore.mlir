@@ -38,3 +38,24 @@ module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 8 :
     tt.return
   }
 }
+
+// -----
+
+// CHECK-DAG: llvm.func spir_funccc @llvm.genx.GenISA.LSC2DBlockWrite.v8i32(i64, i32, i32, i32, i32, i32, i32, i32, i32, i32, i1, i1, i32, vector<8xi32>)
+#dpas = #triton_intel_gpu.dpas<{repeatCount = 8, systolicDepth = 8, executionSize = 16, opsPerChan = 2, threadsPerWarp = 16, warpsPerCTA = [4, 2], A = [8, 16], B = [16, 16], C = [8, 16]}>
+module attributes {"triton_gpu.num-ctas" = 1 : i32, "triton_gpu.num-warps" = 8 : i32, "triton_gpu.threads-per-warp" = 16 : i32} {
+  // CHECK-LABEL: @store_f32_small_tensor
+  tt.func public @store_f32_small_tensor(%arg0: !tt.ptr<f32>, %arg1: i64, %arg2: i64, %arg3: i64) {
+    %cst = arith.constant dense<0.000000e+00> : tensor<16x64xf32, #dpas>
+    %c0_i32 = arith.constant 0 : i32
+    %c1_i64 = arith.constant 1 : i64
+    %0 = tt.make_tensor_ptr %arg0, [%arg1, %arg2], [%arg3, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<16x64xf32, #dpas>>
+    // COM: Only 2 of the 4 warps along the rows hold unique data, the warp id is wrapped.
+    // CHECK: [[TWO:%.*]] = llvm.mlir.constant(2 : i32) : i32
+    // CHECK: llvm.urem %{{.*}}, [[TWO]] : i32
+    // CHECK-COUNT-2: llvm.call spir_funccc @llvm.genx.GenISA.LSC2DBlockWrite.v8i32{{.*}}
+    // CHECK-NOT: llvm.call spir_funccc @llvm.genx.GenISA.LSC2DBlockWrite.v8i32{{.*}}
+    tt.store %0, %cst {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<16x64xf32, #dpas>>
+    tt.return
+  }
+}
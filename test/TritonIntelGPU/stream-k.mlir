@@ -0,0 +1,108 @@
+// RUN: triton-opt %s -split-input-file -tritonintelgpu-stream-k | FileCheck %s
+
+// COM: Case 1:
+// COM: Checks that a matmul kernel using block pointers is rewritten into a persistent kernel: the full waves of tiles
+// COM: are computed in a data parallel loop, the remaining K loop iterations are split across the programs and the
+// COM: partial tiles are accumulated with atomic additions.
+// CHECK: module attributes {"triton_intel_gpu.stream-k" = 1 : i32}
+module {
+  // CHECK-LABEL: tt.func public @matmul_kernel_with_block_pointers
+  // CHECK-SAME:    %[[K:[^:]*]]: i32, %[[NUM_TILES:[^:]*]]: i32) {
+  tt.func public @matmul_kernel_with_block_pointers(%arg0: !tt.ptr<f16>, %arg1: !tt.ptr<f16>, %arg2: !tt.ptr<f32>, %arg3: i64, %arg4: i64, %arg5: i32) {
+    // CHECK:      %[[PID:.*]] = tt.get_program_id x : i32
+    // CHECK-NEXT: %[[NUM_PROGRAMS:.*]] = tt.get_num_programs x : i32
+    // CHECK:      %[[ITERS:.*]] = arith.maxsi
+    // CHECK:      %[[SK_TILES:.*]] = arith.remui %[[NUM_TILES]], %[[NUM_PROGRAMS]] : i32
+    // CHECK:      %[[DP_TILES:.*]] = arith.subi %[[NUM_TILES]], %[[SK_TILES]] : i32
+    // CHECK:      scf.for %[[TILE:.*]] = %[[PID]] to %[[DP_TILES]] step %[[NUM_PROGRAMS]] : i32 {
+    // CHECK:        arith.divsi %[[TILE]], %{{.*}} : i32
+    // CHECK:        scf.for %{{.*}} = %{{.*}} to %[[K]] step %{{.*}} iter_args
+    // CHECK:          tt.dot
+    // CHECK:        tt.store %{{.*}}, %{{.*}} {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x128xf32>>
+    // CHECK:      }
+    // CHECK:      scf.while (%[[ITER:.*]] = %{{.*}}) : (i32) -> i32 {
+    // CHECK:        arith.cmpi slt, %[[ITER]]
+    // CHECK:        scf.condition
+    // CHECK:      } do {
+    // CHECK:      ^bb0(%[[IT:.*]]: i32):
+    // CHECK:        %[[SK_TILE:.*]] = arith.divui %[[IT]], %[[ITERS]] : i32
+    // CHECK:        %[[K_BEGIN:.*]] = arith.remui %[[IT]], %[[ITERS]] : i32
+    // CHECK:        %[[K_END:.*]] = arith.minui %[[ITERS]], %{{.*}} : i32
+    // CHECK:        arith.divsi %[[SK_TILE]], %{{.*}} : i32
+    // CHECK:        tt.advance %{{.*}}, [%{{.*}}, %{{.*}}] : <tensor<64x32xf16>>
+    // CHECK:        tt.advance %{{.*}}, [%{{.*}}, %{{.*}}] : <tensor<32x128xf16>>
+    // CHECK:        scf.for %{{.*}} = %{{.*}} to %{{.*}} step %{{.*}} iter_args
+    // CHECK:          tt.dot
+    // CHECK-NOT:    tt.store
+    // CHECK:        arith.cmpi sge, %{{.*}}, %{{.*}} : tensor<64xi64>
+    // CHECK:        arith.cmpi slt, %{{.*}}, %{{.*}} : tensor<64xi64>
+    // CHECK:        arith.cmpi sge, %{{.*}}, %{{.*}} : tensor<128xi64>
+    // CHECK:        arith.cmpi slt, %{{.*}}, %{{.*}} : tensor<128xi64>
+    // CHECK:        tt.atomic_rmw fadd, relaxed, gpu, %{{.*}}, %{{.*}}, %{{.*}} : (tensor<64x128x!tt.ptr<f32>>, tensor<64x128xf32>, tensor<64x128xi1>) -> tensor<64x128xf32>
+    // CHECK:        scf.yield
+    // CHECK:      }
+    // CHECK-NEXT: tt.return
+    %c1_i64 = arith.constant 1 : i64
+    %c0_i32 = arith.constant 0 : i32
+    %c32_i32 = arith.constant 32 : i32
+    %c64_i32 = arith.constant 64 : i32
+    %c128_i32 = arith.constant 128 : i32
+    %c8_i32 = arith.constant 8 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x128xf32>
+    %0 = tt.get_program_id x : i32
+    %1 = arith.divsi %0, %c8_i32 : i32
+    %2 = arith.remsi %0, %c8_i32 : i32
+    %3 = arith.muli %1, %c64_i32 : i32
+    %4 = arith.muli %2, %c128_i32 : i32
+    %5 = arith.extsi %arg5 : i32 to i64
+    %6 = tt.make_tensor_ptr %arg0, [%arg3, %5], [%5, %c1_i64], [%3, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x32xf16>>
+    %7 = tt.make_tensor_ptr %arg1, [%5, %arg4], [%arg4, %c1_i64], [%c0_i32, %4] {order = array<i32: 1, 0>} : <tensor<32x128xf16>>
+    %8:3 = scf.for %arg6 = %c0_i32 to %arg5 step %c32_i32 iter_args(%arg7 = %cst, %arg8 = %6, %arg9 = %7) -> (tensor<64x128xf32>, !tt.ptr<tensor<64x32xf16>>, !tt.ptr<tensor<32x128xf16>>)  : i32 {
+      %10 = tt.load %arg8 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x32xf16>>
+      %11 = tt.load %arg9 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<32x128xf16>>
+      %12 = tt.dot %10, %11, %arg7, inputPrecision = tf32 : tensor<64x32xf16> * tensor<32x128xf16> -> tensor<64x128xf32>
+      %13 = tt.advance %arg8, [%c0_i32, %c32_i32] : <tensor<64x32xf16>>
+      %14 = tt.advance %arg9, [%c32_i32, %c0_i32] : <tensor<32x128xf16>>
+      scf.yield %12, %13, %14 : tensor<64x128xf32>, !tt.ptr<tensor<64x32xf16>>, !tt.ptr<tensor<32x128xf16>>
+    }
+    %9 = tt.make_tensor_ptr %arg2, [%arg3, %arg4], [%arg4, %c1_i64], [%3, %4] {order = array<i32: 1, 0>} : <tensor<64x128xf32>>
+    tt.store %9, %8#0 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x128xf32>>
+    tt.return
+  }
+}
+
+// -----
+
+// COM: Case 2:
+// COM: Checks that a kernel storing a value computed from the accumulator (which cannot be accumulated atomically
+// COM: across partial tiles) is not rewritten.
+// CHECK-NOT: triton_intel_gpu.stream-k
+module {
+  // CHECK-LABEL: tt.func public @matmul_kernel_fp16_output
+  // CHECK-SAME:    %arg5: i32) {
+  // CHECK-NOT:   scf.while
+  tt.func public @matmul_kernel_fp16_output(%arg0: !tt.ptr<f16>, %arg1: !tt.ptr<f16>, %arg2: !tt.ptr<f16>, %arg3: i64, %arg4: i64, %arg5: i32) {
+    %c1_i64 = arith.constant 1 : i64
+    %c0_i32 = arith.constant 0 : i32
+    %c32_i32 = arith.constant 32 : i32
+    %c64_i32 = arith.constant 64 : i32
+    %cst = arith.constant dense<0.000000e+00> : tensor<64x128xf32>
+    %0 = tt.get_program_id x : i32
+    %1 = arith.muli %0, %c64_i32 : i32
+    %5 = arith.extsi %arg5 : i32 to i64
+    %6 = tt.make_tensor_ptr %arg0, [%arg3, %5], [%5, %c1_i64], [%1, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x32xf16>>
+    %7 = tt.make_tensor_ptr %arg1, [%5, %arg4], [%arg4, %c1_i64], [%c0_i32, %c0_i32] {order = array<i32: 1, 0>} : <tensor<32x128xf16>>
+    %8:3 = scf.for %arg6 = %c0_i32 to %arg5 step %c32_i32 iter_args(%arg7 = %cst, %arg8 = %6, %arg9 = %7) -> (tensor<64x128xf32>, !tt.ptr<tensor<64x32xf16>>, !tt.ptr<tensor<32x128xf16>>)  : i32 {
+      %10 = tt.load %arg8 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x32xf16>>
+      %11 = tt.load %arg9 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<32x128xf16>>
+      %12 = tt.dot %10, %11, %arg7, inputPrecision = tf32 : tensor<64x32xf16> * tensor<32x128xf16> -> tensor<64x128xf32>
+      %13 = tt.advance %arg8, [%c0_i32, %c32_i32] : <tensor<64x32xf16>>
+      %14 = tt.advance %arg9, [%c32_i32, %c0_i32] : <tensor<32x128xf16>>
+      scf.yield %12, %13, %14 : tensor<64x128xf32>, !tt.ptr<tensor<64x32xf16>>, !tt.ptr<tensor<32x128xf16>>
+    }
+    %15 = arith.truncf %8#0 : tensor<64x128xf32> to tensor<64x128xf16>
+    %9 = tt.make_tensor_ptr %arg2, [%arg3, %arg4], [%arg4, %c1_i64], [%1, %c0_i32] {order = array<i32: 1, 0>} : <tensor<64x128xf16>>
+    tt.store %9, %15 {boundaryCheck = array<i32: 0, 1>} : !tt.ptr<tensor<64x128xf16>>
+    tt.return
+  }
+}
@@ -0,0 +1,66 @@
+#include "mlir/Pass/Pass.h"
+#include "triton/Analysis/IntegerRange.h"
+#include "triton/Analysis/Utility.h"
+
+using namespace mlir;
+using namespace mlir::triton;
+
+namespace {
+
+struct TestIntegerRangePass
+    : public PassWrapper<TestIntegerRangePass, OperationPass<ModuleOp>> {
+
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(TestIntegerRangePass);
+
+  StringRef getArgument() const final { return "test-print-integer-range"; }
+  StringRef getDescription() const final {
+    return "print the result of the integer range analysis pass";
+  }
+
+  void runOnOperation() override {
+    ModuleOp moduleOp = getOperation();
+    moduleOp.walk([&](FuncOp funcOp) {
+      std::unique_ptr<DataFlowSolver> solver = createDataFlowSolver();
+      solver->load<IntegerRangeAnalysis>();
+      if (failed(solver->initializeAndRun(funcOp)))
+        return signalPassFailure();
+
+      auto &os = llvm::errs();
+      auto opName = SymbolTable::getSymbolName(funcOp).getValue().str();
+      os << "@" << opName << "\n";
+      auto printRange = [&](Value value) {
+        value.print(os);
+        os << " => ";
+        std::optional<ConstantIntRanges> range =
+            getIntegerRange(*solver, value);
+        // Booleans are printed as unsigned values, other integers as signed.
+        if (range && range->umin().getBitWidth() == 1)
+          os << "[" << range->umin().getZExtValue() << ", "
+             << range->umax().getZExtValue() << "]";
+        else if (range)
+          os << "[" << range->smin().getSExtValue() << ", "
+             << range->smax().getSExtValue() << "]";
+        else
+          os << "<unknown>";
+        os << "\n";
+      };
+      funcOp.walk([&](Operation *op) {
+        for (Region &region : op->getRegions())
+          for (Value arg : region.getArguments())
+            printRange(arg);
+        for (Value result : op->getResults())
+          printRange(result);
+      });
+    });
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace test {
+void registerTestIntegerRangePass() {
+  PassRegistration<TestIntegerRangePass>();
+}
+} // namespace test
+} // namespace mlir
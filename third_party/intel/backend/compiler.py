@@ -4,7 +4,7 @@ from triton.backends.intel.driver import compile_module_from_src
 
 from dataclasses import dataclass
 import functools
-from typing import Any, Tuple
+from typing import Any, Optional, Tuple
 import hashlib
 import re
 import os
@@ -36,8 +36,24 @@ class XPUOptions:
     num_warps: int = 4
     num_ctas: int = 1
     num_stages: int = 2
+    # Number of iterations the loads of a pipelined matmul loop are issued ahead of their uses. The prefetches take
+    # the first stage, so it can be at most num_stages - 2 and has no effect at the default num_stages.
+    load_distance: int = 0
+    stream_k: bool = False
+    # Removes the masks of the loads and stores known to be all true, splitting loops into a mask-free steady state
+    # and a masked tail. Opt-in: the split loops are both pipelined. Only the loops whose offsets are proven not to
+    # wrap around are split.
+    remove_masks: bool = False
+    # Maximum number of operations added by cloning `noinline` functions per call-site alignment, 0 disables it.
+    call_site_specialization_budget: int = 0
     cluster_dims: tuple = (1, 1, 1)
-    threads_per_warp: int = 32
+    # 2 runs the whole optimization pipeline. 1 is a fast compile mode, for latency-sensitive JIT paths, which skips
+    # the pipelining, prefetching and most of the layout optimizations and runs LLVM at -O1. Set by
+    # TRITON_INTEL_OPT_LEVEL by default.
+    opt_level: Optional[int] = None
+    # Chosen from the content of the kernel if not set, see `XPUBackend.get_threads_per_warp`. The value chosen is
+    # reported in the metadata, with the spill size of the kernel once it is loaded.
+    threads_per_warp: Optional[int] = None
     optimize_epilogue: bool = False
     enable_fp_fusion: bool = True
     default_dot_input_precision: str = "tf32"
@@ -56,6 +72,11 @@ class XPUOptions:
             extern_libs['libdevice'] = os.getenv("TRITON_LIBDEVICE_PATH",
                                                  str(default_libdir / 'libsycl-spir64-unknown-unknown.bc'))
         object.__setattr__(self, 'extern_libs', tuple(extern_libs.items()))
+        if self.opt_level is None:
+            object.__setattr__(self, 'opt_level', int(os.getenv("TRITON_INTEL_OPT_LEVEL", "2")))
+        assert self.opt_level in [1, 2], "opt_level must be 1 or 2"
+        assert self.load_distance == 0 or 0 < self.load_distance <= self.num_stages - 2, \
+            f"load_distance must be between 0 and num_stages - 2 ({self.num_stages - 2})"
         assert self.num_warps > 0 and (self.num_warps & (self.num_warps - 1)) == 0, \
             "num_warps must be a power of 2"
 
@@ -112,6 +133,8 @@ class XPUBackend(BaseBackend):
         dev_prop['max_num_sub_groups'] = tgt_prop.get('max_num_sub_groups', None)
         dev_prop['sub_group_sizes'] = tgt_prop.get('sub_group_sizes', None)
         dev_prop['has_fp64'] = tgt_prop.get('has_fp64', None)
+        # shared local memory per work-group in bytes, 0 if unknown
+        dev_prop['max_shared_mem'] = tgt_prop.get('local_mem_size', 0)
         dev_prop['device_arch'] = self.parse_device_arch(tgt_prop.get('device_arch', 0))
         return dev_prop
 
@@ -142,10 +165,32 @@ class XPUBackend(BaseBackend):
         passes.ttir.add_reorder_broadcast(pm)
         passes.common.add_cse(pm)
         passes.common.add_licm(pm)
+        if opt.call_site_specialization_budget > 0:
+            passes.ttir.add_specialize_call_sites(pm, opt.call_site_specialization_budget)
+        if opt.stream_k:
+            intel.passes.ttir.add_stream_k(pm)
+        if opt.remove_masks:
+            intel.passes.ttir.add_remove_masks(pm)
+            passes.common.add_canonicalizer(pm)
         passes.common.add_symbol_dce(pm)
         pm.run(mod)
+        # Stream-K kernels take the number of tiles as an extra argument.
+        metadata["stream_k"] = mod.get_int_attr("triton_intel_gpu.stream-k") == 1
         return mod
 
+    @staticmethod
+    def get_threads_per_warp(mod, metadata, opt):
+        if opt.threads_per_warp is not None:
+            return opt.threads_per_warp
+        # Use 16 threads per warp for kernels with dots (DPAS) or reductions along short axes, 32 otherwise.
+        threads_per_warp = intel.get_preferred_threads_per_warp(mod)
+        sub_group_sizes = metadata["target"].arch.get('sub_group_sizes') or []
+        if sub_group_sizes and threads_per_warp not in sub_group_sizes:
+            other = 32 if threads_per_warp == 16 else 16
+            if other in sub_group_sizes:
+                threads_per_warp = other
+        return threads_per_warp
+
     @staticmethod
     def make_ttgir(mod, metadata, opt, device_arch):
         is_lts = Version(metadata["target"].arch['driver_version']) == Version("1.3.27642")
@@ -155,26 +200,50 @@ class XPUBackend(BaseBackend):
         # TTIR -> TTGIR
         pm = ir.pass_manager(mod.context)
         pm.enable_debug()
-        passes.ttir.add_convert_to_ttgpuir(pm, f"xpu:{device_arch}", opt.num_warps, opt.threads_per_warp, opt.num_ctas)
+        threads_per_warp = XPUBackend.get_threads_per_warp(mod, metadata, opt)
+        metadata["threads_per_warp"] = threads_per_warp
+        passes.ttir.add_convert_to_ttgpuir(pm, f"xpu:{device_arch}", opt.num_warps, threads_per_warp, opt.num_ctas)
         is_lts_driver = Version(metadata["target"].arch['driver_version']) == Version("1.3.27642")
         intel.set_device_properties(mod, is_lts_driver)
 
+        # Only add the passes which can change the module, e.g. elementwise kernels have no dot to optimize and no
+        # loop to pipeline.
+        features = intel.get_module_features(mod)
+        if os.getenv("TRITON_INTEL_FULL_TTGIR_PIPELINE", "0") == "1":
+            features = {name: True for name in features}
+        has_dot = features["dot"]
+        has_dot_loop = has_dot and features["loop"]
+        full = opt.opt_level >= 2
+
         # optimize TTGIR
-        intel.passes.ttgpuir.add_accelerate_matmul(pm)
-        intel.passes.ttgpuir.add_remove_layout_conversions(pm)
-        intel.passes.ttgpuir.add_rewrite_tensor_pointer(pm)
-        intel.passes.ttgpuir.add_pipeline(pm, opt.num_stages, False)
+        if has_dot:
+            intel.passes.ttgpuir.add_accelerate_matmul(pm)
+        if full and has_dot:
+            # propagate the DPAS layouts to the loads, for the pipeliner
+            intel.passes.ttgpuir.add_remove_layout_conversions(pm)
+        if features["tensor_ptr"]:
+            intel.passes.ttgpuir.add_rewrite_tensor_pointer(pm)
+        if full and has_dot_loop:
+            intel.passes.ttgpuir.add_pipeline(pm, opt.num_stages, False, opt.load_distance)
 
         passes.ttgpuir.add_coalesce(pm)
         intel.passes.ttgpuir.add_remove_layout_conversions(pm)
-        passes.ttgpuir.add_optimize_thread_locality(pm)
-        passes.ttgpuir.add_optimize_dot_operands(pm, True)
-        passes.common.add_cse(pm)
-        passes.ttgpuir.add_prefetch(pm)
-        passes.ttgpuir.add_optimize_dot_operands(pm, True)
-        intel.passes.ttgpuir.add_remove_layout_conversions(pm)
-        passes.ttgpuir.add_reduce_data_duplication(pm)
-        passes.ttgpuir.add_reorder_instructions(pm)
+        if full:
+            if features["reduce"]:
+                passes.ttgpuir.add_optimize_thread_locality(pm)
+            if has_dot:
+                passes.ttgpuir.add_optimize_dot_operands(pm, True)
+            passes.common.add_cse(pm)
+            if has_dot_loop:
+                passes.ttgpuir.add_prefetch(pm)
+            if has_dot:
+                passes.ttgpuir.add_optimize_dot_operands(pm, True)
+            if has_dot or features["reduce"]:
+                intel.passes.ttgpuir.add_remove_layout_conversions(pm)
+        if has_dot:
+            passes.ttgpuir.add_reduce_data_duplication(pm)
+        if full:
+            passes.ttgpuir.add_reorder_instructions(pm)
         passes.common.add_cse(pm)
         passes.common.add_symbol_dce(pm)
         passes.common.add_canonicalizer(pm)
@@ -182,7 +251,7 @@ class XPUBackend(BaseBackend):
         return mod
 
     @staticmethod
-    def make_llir(src, metadata, options):
+    def make_llir(src, metadata, options, max_shared_mem):
         # warp-specialization mutates num_warps
         num_warp_groups = src.get_int_attr("triton_gpu.num-warp-groups-per-cta")
         if num_warp_groups is not None:
@@ -196,7 +265,7 @@ class XPUBackend(BaseBackend):
         intel.passes.ttgpuir.add_decompose_unsupported_conversions(pm)
         passes.convert.add_scf_to_cf(pm)
         passes.convert.add_index_to_llvmir(pm)
-        intel.passes.ttgpuir.add_allocate_shared_memory(pm)
+        intel.passes.ttgpuir.add_allocate_shared_memory(pm, max_shared_mem)
         intel.passes.ttgpuir.add_to_llvmir(pm)
         passes.convert.add_arith_to_llvmir(pm)
         passes.common.add_canonicalizer(pm)
@@ -213,7 +282,7 @@ class XPUBackend(BaseBackend):
         if options.extern_libs:
             paths = [path for (name, path) in options.extern_libs]
             llvm.link_extern_libs(llvm_mod, paths)
-        llvm.optimize_module(llvm_mod, llvm.OPTIMIZE_O3)
+        llvm.optimize_module(llvm_mod, llvm.OPTIMIZE_O3 if options.opt_level >= 2 else llvm.OPTIMIZE_O1)
         intel.post_process_llir(llvm_mod)
 
         # Get some metadata
@@ -232,7 +301,7 @@ class XPUBackend(BaseBackend):
     def add_stages(self, stages, options):
         stages["ttir"] = lambda src, metadata: self.make_ttir(src, metadata, options)
         stages["ttgir"] = lambda src, metadata: self.make_ttgir(src, metadata, options, self.device_arch)
-        stages["llir"] = lambda src, metadata: self.make_llir(src, metadata, options)
+        stages["llir"] = lambda src, metadata: self.make_llir(src, metadata, options, self.properties["max_shared_mem"])
         stages["spv"] = lambda src, metadata: self.make_spv(src, metadata)
 
     @functools.lru_cache()
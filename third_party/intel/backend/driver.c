@@ -6,10 +6,14 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
 #include <level_zero/ze_api.h>
+#include <list>
+#include <regex>
 #include <string>
+#include <string_view>
 #include <sycl/sycl.hpp>
 #include <unordered_map>
 #include <utility>
@@ -125,7 +129,8 @@ bool getBoolEnv(const std::string &env) {
 
 ze_module_handle_t create_module(ze_context_handle_t context,
                                  ze_device_handle_t device,
-                                 uint32_t *binary_ptr, size_t binary_size) {
+                                 uint32_t *binary_ptr, size_t binary_size,
+                                 std::string &build_log) {
   const char *build_flags = "";
   const ze_module_format_t format = ZE_MODULE_FORMAT_IL_SPIRV;
   ze_module_desc_t module_description = {};
@@ -142,19 +147,91 @@ ze_module_handle_t create_module(ze_context_handle_t context,
   auto error_no = ZE_RESULT_SUCCESS;
   error_no =
       zeModuleCreate(context, device, &module_description, &module, &buildlog);
-  if (error_no != ZE_RESULT_SUCCESS) {
-    size_t szLog = 0;
-    ZE_CHECK(zeModuleBuildLogGetString(buildlog, &szLog, nullptr));
-    char *strLog = (char *)malloc(szLog);
-    ZE_CHECK(zeModuleBuildLogGetString(buildlog, &szLog, strLog));
+  size_t szLog = 0;
+  ZE_CHECK(zeModuleBuildLogGetString(buildlog, &szLog, nullptr));
+  char *strLog = (char *)malloc(szLog);
+  ZE_CHECK(zeModuleBuildLogGetString(buildlog, &szLog, strLog));
+  if (error_no != ZE_RESULT_SUCCESS)
     std::cerr << "L0 build module failed. Log: " << strLog << std::endl;
-    free(strLog);
-    ZE_CHECK(zeModuleBuildLogDestroy(buildlog));
-  }
+  build_log = strLog;
+  free(strLog);
+  ZE_CHECK(zeModuleBuildLogDestroy(buildlog));
   ZE_CHECK(error_no);
   return module;
 }
 
+// Modules built to report the resources of a kernel, reused when the kernel
+// is loaded. Identified by device id and SPIR-V binary, the oldest ones are
+// destroyed past max_built_modules. The hash only speeds up the lookup, the
+// binaries are compared on a match.
+struct BuiltModule {
+  int devId;
+  size_t binary_hash;
+  std::string binary;
+  ze_module_handle_t module;
+  std::string build_log;
+};
+static std::list<BuiltModule> built_modules;
+static constexpr size_t max_built_modules = 16;
+
+std::string_view binary_view(uint32_t *binary_ptr, size_t binary_size) {
+  return std::string_view((const char *)binary_ptr,
+                          binary_size * sizeof(uint32_t));
+}
+
+std::list<BuiltModule>::iterator
+find_built_module(int devId, uint32_t *binary_ptr, size_t binary_size) {
+  std::string_view binary = binary_view(binary_ptr, binary_size);
+  size_t binary_hash = std::hash<std::string_view>{}(binary);
+  return std::find_if(built_modules.begin(), built_modules.end(),
+                      [&](const BuiltModule &built) {
+                        return built.devId == devId &&
+                               built.binary_hash == binary_hash &&
+                               built.binary == binary;
+                      });
+}
+
+ze_module_handle_t get_module(int devId, uint32_t *binary_ptr,
+                              size_t binary_size, std::string &build_log,
+                              bool take) {
+  auto it = find_built_module(devId, binary_ptr, binary_size);
+  if (it != built_modules.end()) {
+    ze_module_handle_t module = it->module;
+    build_log = it->build_log;
+    if (take)
+      built_modules.erase(it);
+    return module;
+  }
+
+  sycl::device sycl_device = sycl_l0_device_list[devId].first;
+  auto ctx = sycl_device.get_platform().ext_oneapi_get_default_context();
+  auto l0_device =
+      sycl::get_native<sycl::backend::ext_oneapi_level_zero>(sycl_device);
+  auto l0_context = sycl::get_native<sycl::backend::ext_oneapi_level_zero>(ctx);
+  ze_module_handle_t module =
+      create_module(l0_context, l0_device, binary_ptr, binary_size, build_log);
+  if (!module || take)
+    return module;
+  if (built_modules.size() == max_built_modules) {
+    ZE_CHECK(zeModuleDestroy(built_modules.front().module));
+    built_modules.pop_front();
+  }
+  std::string_view binary = binary_view(binary_ptr, binary_size);
+  built_modules.push_back({devId, std::hash<std::string_view>{}(binary),
+                           std::string(binary), module, build_log});
+  return module;
+}
+
+// IGC only reports the number of registers of kernels which spill, e.g.
+// "kernel foo compiled SIMD16 allocated 128 regs and spilled around 64".
+int32_t get_num_regs(const std::string &build_log) {
+  std::smatch match;
+  if (std::regex_search(build_log, match,
+                        std::regex("allocated ([0-9]+) regs")))
+    return std::stoi(match[1]);
+  return 0;
+}
+
 void printModuleKernelName(ze_module_handle_t hModule) {
   uint32_t Count = 0;
   auto ret = zeModuleGetKernelNames(hModule, &Count, nullptr);
@@ -220,13 +297,10 @@ static PyObject *loadBinary(PyObject *self, PyObject *args) {
   binary_size = binary_size / sizeof(uint32_t);
 
   uint32_t *binary_ptr = (uint32_t *)PyBytes_AsString(py_bytes);
-  ;
   auto ctx = sycl_device.get_platform().ext_oneapi_get_default_context();
-  auto l0_device =
-      sycl::get_native<sycl::backend::ext_oneapi_level_zero>(sycl_device);
-  auto l0_context = sycl::get_native<sycl::backend::ext_oneapi_level_zero>(ctx);
+  std::string build_log;
   auto l0_module =
-      create_module(l0_context, l0_device, binary_ptr, binary_size);
+      get_module(devId, binary_ptr, binary_size, build_log, /*take=*/true);
 
   if (PyErr_Occurred()) {
     // check for errors from module creation
@@ -244,6 +318,7 @@ static PyObject *loadBinary(PyObject *self, PyObject *args) {
   props.stype = ZE_STRUCTURE_TYPE_KERNEL_PROPERTIES;
   props.pNext = nullptr;
   ZE_CHECK(zeKernelGetProperties(l0_kernel, &props));
+  n_regs = get_num_regs(build_log);
   n_spills = props.spillMemSize;
   auto mod = sycl::make_kernel_bundle<sycl::backend::ext_oneapi_level_zero,
                                       sycl::bundle_state::executable>(
@@ -267,6 +342,69 @@ static PyObject *loadBinary(PyObject *self, PyObject *args) {
       new sycl::kernel_bundle<sycl::bundle_state::executable>(mod);
   return Py_BuildValue("(KKii)", (uint64_t)kb, (uint64_t)k, n_regs, n_spills);
 }
+
+// Builds the kernel \p name of the SPIR-V binary and returns the resources it
+// uses. The module is kept to be reused by loadBinary.
+static PyObject *getKernelResources(PyObject *self, PyObject *args) {
+  const char *name;
+  PyObject *py_bytes;
+  int devId;
+
+  if (!PyArg_ParseTuple(args, "sSi", &name, &py_bytes, &devId)) {
+    std::cerr << "getKernelResources arg parse failed" << std::endl;
+    return NULL;
+  }
+
+  if (devId >= sycl_l0_device_list.size()) {
+    std::cerr << "Device is not found " << std::endl;
+    return NULL;
+  }
+
+  size_t binary_size = PyBytes_Size(py_bytes) / sizeof(uint32_t);
+  uint32_t *binary_ptr = (uint32_t *)PyBytes_AsString(py_bytes);
+  std::string build_log;
+  auto l0_module =
+      get_module(devId, binary_ptr, binary_size, build_log, /*take=*/false);
+  if (PyErr_Occurred())
+    return NULL;
+
+  auto l0_kernel = create_function(l0_module, name);
+  if (PyErr_Occurred())
+    return NULL;
+
+  ze_kernel_properties_t props;
+  props.stype = ZE_STRUCTURE_TYPE_KERNEL_PROPERTIES;
+  props.pNext = nullptr;
+  ZE_CHECK(zeKernelGetProperties(l0_kernel, &props));
+  ZE_CHECK(zeKernelDestroy(l0_kernel));
+
+  return Py_BuildValue("{s:i, s:I, s:I, s:I}", "n_regs",
+                       get_num_regs(build_log), "n_spills", props.spillMemSize,
+                       "private_mem_size", props.privateMemSize,
+                       "local_mem_size", props.localMemSize);
+}
+
+// Destroys the module built by getKernelResources for the SPIR-V binary, when
+// the kernel won't be loaded.
+static PyObject *releaseKernelResources(PyObject *self, PyObject *args) {
+  PyObject *py_bytes;
+  int devId;
+
+  if (!PyArg_ParseTuple(args, "Si", &py_bytes, &devId)) {
+    std::cerr << "releaseKernelResources arg parse failed" << std::endl;
+    return NULL;
+  }
+
+  size_t binary_size = PyBytes_Size(py_bytes) / sizeof(uint32_t);
+  uint32_t *binary_ptr = (uint32_t *)PyBytes_AsString(py_bytes);
+  auto it = find_built_module(devId, binary_ptr, binary_size);
+  if (it != built_modules.end()) {
+    ze_module_handle_t module = it->module;
+    built_modules.erase(it);
+    ZE_CHECK(zeModuleDestroy(module));
+  }
+  Py_RETURN_NONE;
+}
 /*Sycl code end*/
 
 bool update(sycl::queue sycl_queue) {
@@ -351,6 +489,10 @@ static PyObject *initDevices(PyObject *self, PyObject *args) {
 static PyMethodDef ModuleMethods[] = {
     {"load_binary", loadBinary, METH_VARARGS,
      "Load provided SPV into ZE driver"},
+    {"get_kernel_resources", getKernelResources, METH_VARARGS,
+     "Build provided SPV and return the resources used by the kernel"},
+    {"release_kernel_resources", releaseKernelResources, METH_VARARGS,
+     "Destroy the build of provided SPV kept by get_kernel_resources"},
     {"get_device_properties", getDeviceProperties, METH_VARARGS,
      "Get the properties for a given device"},
     {"init_context", initContext, METH_VARARGS,
@@ -56,6 +56,8 @@ class XPUUtils(object):
         dirname = os.path.dirname(os.path.realpath(__file__))
         mod = compile_module_from_src(Path(os.path.join(dirname, "driver.c")).read_text(), "spirv_utils")
         self.load_binary = mod.load_binary
+        self.get_kernel_resources = mod.get_kernel_resources
+        self.release_kernel_resources = mod.release_kernel_resources
         self.get_device_properties = mod.get_device_properties
         self.context = mod.init_context(self.get_sycl_queue())
         self.device_count = mod.init_devices(self.get_sycl_queue())
@@ -382,12 +384,23 @@ class XPULauncher(object):
         cst_key = lambda i: src.fn.arg_names.index(i) if isinstance(i, str) else i
         constants = {cst_key(key): value for key, value in constants.items()}
         signature = {cst_key(key): value for key, value in src.signature.items()}
+        # Stream-K kernels take the number of tiles as an extra trailing argument and
+        # are launched with (at most) one program per Xe core.
+        self.stream_k = getattr(metadata, "stream_k", False)
+        if self.stream_k:
+            signature[max([*signature.keys(), *constants.keys()], default=-1) + 1] = "i32"
+            self.num_programs = metadata.target.arch.get("gpu_subslice_count", None)
         src = make_launcher(constants, signature, ids)
         mod = compile_module_from_src(src, "__triton_launcher")
         self.launch = mod.launch
 
-    def __call__(self, *args, **kwargs):
-        self.launch(*args, **kwargs)
+    def __call__(self, gridX, gridY, gridZ, *args, **kwargs):
+        if self.stream_k:
+            num_tiles = gridX
+            if self.num_programs:
+                gridX = min(gridX, self.num_programs)
+            args = (*args, num_tiles)
+        self.launch(gridX, gridY, gridZ, *args, **kwargs)
 
 
 class XPUDriver(DriverBase):
@@ -10,6 +10,7 @@
 #define TRITON_DIALECT_TRITONINTELGPU_TRANSFORMS_UTILITY_H
 
 #include "triton/Dialect/Triton/IR/Dialect.h"
+#include "llvm/ADT/DenseMap.h"
 
 #include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h"
 
@@ -37,6 +38,10 @@ enum class DPASEngineType : uint8_t {
 bool supportDPAS(DotOp op, DeviceArch arch);
 DPASEngineType getDPASType(DotOp op);
 
+// Returns true if \p type is a FP8 type, which is upconverted to FP16 in
+// registers to be fed to the DPAS engine.
+bool isUpconvertedFP8Type(Type type);
+
 // Infers the encoding of the source of op given the result encoding.
 std::optional<Attribute> inferSrcEncoding(Operation *op, Attribute encoding);
 
@@ -69,6 +74,102 @@ LLVM::CallOp createSPIRVBuiltinCall(Location loc,
                                     LLVM::LLVMFuncOp func, ValueRange args);
 
 DeviceArch getDeviceArch(Operation *module);
+
+// Encode the native operation sizes supported by the target architecture.
+class TargetArchNativeSizes {
+public:
+  struct DotShape {
+    DotShape(unsigned m, unsigned n, unsigned k) : m(m), n(n), k(k) {
+      assert(m != 0 && n != 0 && k != 0 && "expecting valid shape");
+    }
+
+    unsigned m;
+    unsigned n;
+    unsigned k;
+  };
+
+  // Shape constraints of the 2D block reads of a dot operand.
+  struct BlockIOShape {
+    BlockIOShape(unsigned blockWidth, unsigned maxArrayLength,
+                 unsigned maxHeight)
+        : blockWidth(blockWidth), maxArrayLength(maxArrayLength),
+          maxHeight(maxHeight) {
+      assert(blockWidth != 0 && maxArrayLength != 0 && maxHeight != 0 &&
+             "expecting valid shape");
+    }
+
+    /// Width (in elements) of a block.
+    unsigned blockWidth;
+    /// Maximum number of blocks read side by side by one instruction.
+    unsigned maxArrayLength;
+    /// Maximum number of rows read by one instruction.
+    unsigned maxHeight;
+  };
+
+  struct BlockMemShape {
+    BlockMemShape(BlockIOShape a, BlockIOShape b) : a(a), b(b) {}
+
+    /// Shape of the reads of the A operand.
+    BlockIOShape a;
+    /// Shape of the (VNNI transformed) reads of the B operand.
+    BlockIOShape b;
+  };
+
+  TargetArchNativeSizes() = default;
+
+  void setDotShape(unsigned bitWidth, DotShape &&shape) {
+    assert(!dotShapes.contains(bitWidth) && "Dot shape already set");
+    dotShapes.try_emplace(bitWidth, std::move(shape));
+  }
+  void setBlockMemShape(unsigned bitWidth, BlockMemShape &&shape) {
+    assert(!blockMemShapes.contains(bitWidth) &&
+           "Block memory access shape already set");
+    blockMemShapes.try_emplace(bitWidth, std::move(shape));
+  }
+  void setBlockSize(unsigned height, unsigned rowBytes) {
+    maxBlockHeight = height;
+    maxBlockRowBytes = rowBytes;
+  }
+  void setLoadStoreSize(unsigned size) { loadStoreSize = size; }
+  const DotShape &getDotShape(unsigned bitWidth) const {
+    assert(dotShapes.contains(bitWidth) &&
+           "No dot shape configured for bit width");
+    return dotShapes.at(bitWidth);
+  }
+  const BlockMemShape &getBlockMemShape(unsigned bitWidth) const {
+    assert(blockMemShapes.contains(bitWidth) &&
+           "No block memory access shape configured for bit width");
+    return blockMemShapes.at(bitWidth);
+  }
+  unsigned getMaxBlockHeight() const { return maxBlockHeight; }
+  unsigned getMaxBlockRowBytes() const { return maxBlockRowBytes; }
+  unsigned getLoadStoreSize() const { return loadStoreSize; }
+
+private:
+  /// Stores the natively supported dot shape per bitwidth of the operand data
+  /// type, e.g. 16 -> 8x16x16 (MxKxN) for [b]float16 on PVC.
+  llvm::SmallDenseMap<unsigned, DotShape> dotShapes;
+  /// Stores the natively supported shapes for 2D block reads of dot operands,
+  /// per element type bitwidth.
+  llvm::SmallDenseMap<unsigned, BlockMemShape> blockMemShapes;
+  /// Maximum number of rows and of bytes per row of a 2D block access (0 if
+  /// the target has no 2D block accesses).
+  unsigned maxBlockHeight = 0;
+  unsigned maxBlockRowBytes = 0;
+  /// Maximum size (in double words) of a load/store.
+  unsigned loadStoreSize = 0;
+};
+
+// Returns the native operation sizes supported by \p arch. An unknown
+// architecture is assumed to match PVC.
+TargetArchNativeSizes getTargetArchNativeSizes(DeviceArch arch);
+// Returns the native operation sizes supported by the target architecture of
+// \p module, or by PVC if the module has no target.
+TargetArchNativeSizes getTargetArchNativeSizes(Operation *module);
+
+// Returns the number of threads per warp (16 or 32) expected to perform best
+// for the Triton IR module \p mod, based on its dot and reduction operations.
+unsigned getPreferredThreadsPerWarp(ModuleOp mod);
 } // namespace mlir::triton::gpu::intel
 
 #endif // TRITON_DIALECT_TRITONINTELGPU_TRANSFORMS_UTILITY_H
@@ -89,6 +89,13 @@ template <typename Op> static LogicalResult verifyMatrixReadInput(Op op) {
                 "Unexpected template parameter");
 
   uint32_t tileWidth = op.getTileWidth();
+  if (op.getTranspose()) {
+    if (tileWidth != 1 && tileWidth != 2 && tileWidth != 4 && tileWidth != 8)
+      return op->emitOpError("tile_width when transpose is true should be "
+                             "equal to 1, 2, 4, or 8");
+    return success();
+  }
+
   if (op.getElemSizeInBits() == 32 && tileWidth != 8 && tileWidth != 16)
     return op->emitOpError(
         "tile_width for 32 bit elements should be equal to either be 8 or 16");
@@ -228,9 +235,9 @@ LogicalResult TritonGEN::Matrix2DBlockStoreOp::verify() {
   if (verifyMatrixInput(*this).failed())
     return failure();
 
-  if (getElemSizeInBits() == 32 && getTileWidth() != 8)
-    return emitOpError("tile_width for 32 bit elements should be equal "
-                       "to systolic depth, i.e., 8 elements");
+  if (getElemSizeInBits() == 32 && getTileWidth() != 8 && getTileWidth() != 16)
+    return emitOpError(
+        "tile_width for 32 bit elements should be equal to either be 8 or 16");
 
   return success();
 }
@@ -216,6 +216,15 @@ static bool isOCLBuiltinAvailable(TritonGEN::Matrix2DBlockLoadOp op) {
       op.getTileWidth() == 32 && op.getVBlocks() == 1)
     return false;
 
+  // The 8 bit VNNI transformed reads are only provided for 32 rows high tiles.
+  if (op.getElemSizeInBits() == 8 && op.getVnniTransform() &&
+      op.getTileHeight() != 32)
+    return false;
+
+  // Transposed reads are only provided for 8 columns wide tiles.
+  if (op.getTranspose() && op.getTileWidth() != 8)
+    return false;
+
   if (op.getCacheControl() != TritonGEN::LoadCacheControl::DEFAULT)
     return false;
 
@@ -1058,6 +1067,31 @@ struct TritonSubGroupShuffleLowering
   }
 };
 
+struct TritonSubGroupBallotLowering
+    : public ConvertOpToLLVMPattern<TritonGEN::SubGroupBallotOp> {
+  using ConvertOpToLLVMPattern<
+      TritonGEN::SubGroupBallotOp>::ConvertOpToLLVMPattern;
+
+  LogicalResult
+  matchAndRewrite(TritonGEN::SubGroupBallotOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    MLIRContext *ctx = rewriter.getContext();
+    intel::AttrBuilder funcAttrBuilder(*ctx);
+    funcAttrBuilder.addPassthroughAttribute(llvm::Attribute::Convergent);
+    intel::AttrBuilder paramAttrBuilder(*ctx);
+    paramAttrBuilder.addAttribute(llvm::Attribute::ZExt);
+    SmallVector<NamedAttrList> paramAttrs{paramAttrBuilder.getAttributes()};
+    intel::AttributeList attrs = getAttrList(funcAttrBuilder, paramAttrs);
+
+    Value val = op.getValue();
+    LLVM::CallOp callOp = createDeviceFunctionCall(
+        rewriter, "_Z22intel_sub_group_ballotb", i32_ty, {val.getType()}, {val},
+        attrs);
+    rewriter.replaceOp(op, callOp);
+    return success();
+  }
+};
+
 //===----------------------------------------------------------------------===//
 // Matrix operations
 //===----------------------------------------------------------------------===//
@@ -1191,9 +1225,9 @@ void mlir::triton::populateTritonGENToLLVMConversionPatterns(
       TritonGENSplitBarrierSignalLowering, TritonGENSplitBarrierWaitLowering,
       TritonGENNamedBarrierSignalLowering, TritonGENNamedBarrierWaitLowering,
       TritonSubGroupReduceLowering, TritonSubGroupShuffleLowering,
-      TritonMatrixDPASLowering, TritonMatrix2DBlockLoadLowering,
-      TritonMatrix2DBlockStoreLowering, TritonMatrix2DBlockPrefetchLowering>(
-      converter);
+      TritonSubGroupBallotLowering, TritonMatrixDPASLowering,
+      TritonMatrix2DBlockLoadLowering, TritonMatrix2DBlockStoreLowering,
+      TritonMatrix2DBlockPrefetchLowering>(converter);
 }
 
 void registerConvertTritonTritonGENToLLVMInterface(DialectRegistry &registry) {
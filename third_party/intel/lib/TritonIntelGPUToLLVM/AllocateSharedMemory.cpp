@@ -1,5 +1,6 @@
 
 #include "intel/include/Dialect/TritonGEN/IR/TritonGENDialect.h"
+#include "intel/include/Dialect/TritonIntelGPU/IR/Dialect.h"
 #include "intel/include/TritonIntelGPUToLLVM/Passes.h"
 #include "mlir/Dialect/LLVMIR/LLVMTypes.h"
 #include "triton/Analysis/Allocation.h"
@@ -24,8 +25,33 @@ struct AllocateSharedMemory
     MLIRContext *ctx = &getContext();
     ModuleAllocation allocation(mod);
 
+    // Buffers explicitly allocated by `triton_intel_gpu.alloc` operations (in
+    // the warp distributed pipeline) are placed after the buffers assigned by
+    // the allocation analysis.
+    constexpr int64_t alignment = 128;
+    int64_t sharedMemorySize = allocation.getSharedMemorySize();
+    bool hasAllocOps = false;
+    mod.walk([&](triton::gpu::intel::AllocOp op) {
+      sharedMemorySize = llvm::alignTo(sharedMemorySize, alignment);
+      op->setAttr("allocation.offset",
+                  IntegerAttr::get(IntegerType::get(ctx, 32),
+                                   sharedMemorySize));
+      sharedMemorySize += op.getSize();
+      hasAllocOps = true;
+    });
+    // The kernels only using the buffers of the allocation analysis are
+    // checked when loaded, so that the autotuner can prune their configs.
+    if (hasAllocOps && maxSharedMemory > 0 &&
+        sharedMemorySize > maxSharedMemory) {
+      mod.emitError() << "the triton_intel_gpu.alloc buffers need "
+                      << sharedMemorySize
+                      << " bytes of shared local memory, more than the "
+                      << maxSharedMemory << " bytes of the device";
+      return signalPassFailure();
+    }
+
     mod.walk([&](FunctionOpInterface funcOp) {
-      if (allocation.isRoot(funcOp) && allocation.getSharedMemorySize()) {
+      if (allocation.isRoot(funcOp) && sharedMemorySize) {
         LLVM::LLVMPointerType ptrTy = LLVM::LLVMPointerType::get(
             ctx, triton::TritonGEN::TritonGENMemorySpace::kWorkgroup);
         funcOp.insertArgument(funcOp.getNumArguments(), ptrTy, {},
@@ -50,8 +76,7 @@ struct AllocateSharedMemory
       });
     });
     mod->setAttr("triton_gpu.shared",
-                 IntegerAttr::get(IntegerType::get(ctx, 32),
-                                  allocation.getSharedMemorySize()));
+                 IntegerAttr::get(IntegerType::get(ctx, 32), sharedMemorySize));
   }
 };
 
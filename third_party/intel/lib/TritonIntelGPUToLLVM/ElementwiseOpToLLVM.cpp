@@ -15,6 +15,82 @@ static SmallVector<Value> identity_func(Location loc,
 
 namespace {
 
+/* ----- Packed FP8 -> FP16/BF16 ------ */
+// The upconversions from FP8 work on four values at a time. The four bytes are
+// packed into a single i32, which is then split into two i32 words holding the
+// pairs {v[0], v[1]} and {v[2], v[3]} in the high byte of each 16-bit lane.
+// The bit manipulation is done on whole words with per-lane masks and the
+// arithmetic on <2 x half> vectors, so each operation handles two lanes.
+static std::pair<Value, Value>
+packFp8x4ToFp16x2Words(Location loc, ConversionPatternRewriter &rewriter,
+                       const SmallVector<Value> &v) {
+  auto fp8x4VecTy = vec_ty(i8_ty, 4);
+  Value fp8x4Vec = undef(fp8x4VecTy);
+  for (unsigned i = 0; i < 4; ++i)
+    fp8x4Vec = insert_element(fp8x4VecTy, fp8x4Vec, v[i], i32_val(i));
+  fp8x4Vec = bitcast(fp8x4Vec, i32_ty);
+
+  Value w0 = or_(i32_ty,
+                 and_(i32_ty, shl(i32_ty, fp8x4Vec, i32_val(8)),
+                      i32_val(0x0000ff00)),
+                 and_(i32_ty, shl(i32_ty, fp8x4Vec, i32_val(16)),
+                      i32_val(0xff000000)));
+  Value w1 = or_(i32_ty,
+                 and_(i32_ty, lshr(i32_ty, fp8x4Vec, i32_val(8)),
+                      i32_val(0x0000ff00)),
+                 and_(i32_ty, fp8x4Vec, i32_val(0xff000000)));
+  return {w0, w1};
+}
+
+static Value splatI16x2(Location loc, ConversionPatternRewriter &rewriter,
+                        uint16_t val) {
+  return i32_val((static_cast<uint32_t>(val) << 16) | val);
+}
+
+// Returns a <2 x i1> mask of the 16-bit lanes of `word` whose bits selected by
+// `mask` are equal to `pattern`.
+static Value matchI16x2Lanes(Location loc, ConversionPatternRewriter &rewriter,
+                             Value word, uint16_t mask, uint16_t pattern) {
+  auto i16x2VecTy = vec_ty(i16_ty, 2);
+  Value lanes =
+      bitcast(and_(i32_ty, word, splatI16x2(loc, rewriter, mask)), i16x2VecTy);
+  return icmp_eq(lanes,
+                 bitcast(splatI16x2(loc, rewriter, pattern), i16x2VecTy));
+}
+
+static Value getFp16x2NaN(Location loc, ConversionPatternRewriter &rewriter) {
+  return bitcast(splatI16x2(loc, rewriter, 0x7e00), vec_ty(f16_ty, 2));
+}
+
+static SmallVector<Value> unpackFp16x2(Location loc,
+                                       ConversionPatternRewriter &rewriter,
+                                       ArrayRef<Value> fp16x2Vecs) {
+  SmallVector<Value> res;
+  for (Value fp16x2Vec : fp16x2Vecs) {
+    res.push_back(extract_element(f16_ty, fp16x2Vec, i32_val(0)));
+    res.push_back(extract_element(f16_ty, fp16x2Vec, i32_val(1)));
+  }
+  return res;
+}
+
+// Every FP8 value is exactly representable in FP16 and, once widened to FP32,
+// has at most 3 significant mantissa bits. The BF16 result is therefore the
+// upper half of the FP32 value, subnormals, infinities and NaNs included.
+static SmallVector<Value>
+unpackFp16x2AsBf16(Location loc, ConversionPatternRewriter &rewriter,
+                   ArrayRef<Value> fp16x2Vecs) {
+  auto bf16x4VecTy = vec_ty(bf16_ty, 4);
+  SmallVector<Value> res;
+  for (Value fp16x2Vec : fp16x2Vecs) {
+    Value fp32x2Vec =
+        rewriter.create<LLVM::FPExtOp>(loc, vec_ty(f32_ty, 2), fp16x2Vec);
+    Value bf16x4Vec = bitcast(fp32x2Vec, bf16x4VecTy);
+    res.push_back(extract_element(bf16_ty, bf16x4Vec, i32_val(1)));
+    res.push_back(extract_element(bf16_ty, bf16x4Vec, i32_val(3)));
+  }
+  return res;
+}
+
 /* ----- FP8E5M2 ------ */
 // This data-type is the standard FP8E5M2 format
 static SmallVector<Value>
@@ -69,117 +145,20 @@ Fp16_to_Fp8E5M2_RTNE_func(Location loc, ConversionPatternRewriter &rewriter,
 static SmallVector<Value>
 Fp8E5M2_to_Fp16_func(Location loc, ConversionPatternRewriter &rewriter,
                      const SmallVector<Value> &v) {
-  auto fp8x4VecTy = vec_ty(i8_ty, 4);
-  Value a0 = undef(fp8x4VecTy);
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(0));
-  a0 = insert_element(fp8x4VecTy, a0, v[0], i32_val(1));
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(2));
-  a0 = insert_element(fp8x4VecTy, a0, v[1], i32_val(3));
-  a0 = bitcast(a0, i32_ty);
-  Value a1 = undef(fp8x4VecTy);
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(0));
-  a1 = insert_element(fp8x4VecTy, a1, v[2], i32_val(1));
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(2));
-  a1 = insert_element(fp8x4VecTy, a1, v[3], i32_val(3));
-  a1 = bitcast(a1, i32_ty);
-
+  // FP8E5M2 is the upper byte of FP16, no adjustment is needed.
+  auto [w0, w1] = packFp8x4ToFp16x2Words(loc, rewriter, v);
   auto fp16x2VecTy = vec_ty(f16_ty, 2);
-  auto fp16x2Vec0 = bitcast(a0, fp16x2VecTy);
-  auto fp16x2Vec1 = bitcast(a1, fp16x2VecTy);
-
-  return {extract_element(f16_ty, fp16x2Vec0, i32_val(0)),
-          extract_element(f16_ty, fp16x2Vec0, i32_val(1)),
-          extract_element(f16_ty, fp16x2Vec1, i32_val(0)),
-          extract_element(f16_ty, fp16x2Vec1, i32_val(1))};
+  return unpackFp16x2(loc, rewriter,
+                      {bitcast(w0, fp16x2VecTy), bitcast(w1, fp16x2VecTy)});
 }
 
 static SmallVector<Value>
 Fp8E5M2_to_Bf16_func(Location loc, ConversionPatternRewriter &rewriter,
                      const SmallVector<Value> &v) {
-  auto fp8x4VecTy = vec_ty(i8_ty, 4);
-  Value a0 = undef(fp8x4VecTy);
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(0));
-  a0 = insert_element(fp8x4VecTy, a0, v[0], i32_val(1));
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(2));
-  a0 = insert_element(fp8x4VecTy, a0, v[1], i32_val(3));
-  a0 = bitcast(a0, i32_ty);
-
-  Value a1 = undef(fp8x4VecTy);
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(0));
-  a1 = insert_element(fp8x4VecTy, a1, v[2], i32_val(1));
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(2));
-  a1 = insert_element(fp8x4VecTy, a1, v[3], i32_val(3));
-  a1 = bitcast(a1, i32_ty);
-
-  Value b0 = and_(i32_ty, a0, i32_val(0x7fff7fff));
-  Value b1 = and_(i32_ty, a1, i32_val(0x7fff7fff));
-  // In i32 original fp8 exponent is b0 >> 26
-  // bf16's 5-bit exponent in the top 2 bytes of i32 is at b0 >> 23
-  // 2^5-1 << 23 = 0xf800000
-  b0 = lshr(i32_ty, b0, i32_val(3));
-  b1 = lshr(i32_ty, b1, i32_val(3));
-
-  Value c0 = and_(i32_ty, b0, i32_val(0xffff0000));
-  Value c1 = shl(i32_ty, b0, i32_val(16));
-  Value c2 = and_(i32_ty, b1, i32_val(0xffff0000));
-  Value c3 = shl(i32_ty, b1, i32_val(16));
-
-  auto i32x4VecTy = vec_ty(i32_ty, 4);
-  Value predefined = undef(i32x4VecTy);
-  predefined = insert_element(i32x4VecTy, predefined, i32_val(0x0), i32_val(0));
-  predefined =
-      insert_element(i32x4VecTy, predefined, i32_val(0x37800000), i32_val(1));
-  predefined =
-      insert_element(i32x4VecTy, predefined, i32_val(0x38000000), i32_val(2));
-  predefined =
-      insert_element(i32x4VecTy, predefined, i32_val(0x38400000), i32_val(3));
-  // Check if the exponent is zero, i.e. subnormal number.
-  // depending on the significand value normalization goes like:
-  //  [00] -> 0x0
-  //  [01] -> exp=127-16, sig=0x0
-  //  [10] -> exp=127-15, sig=0x0
-  //  [11] -> exp=127-15, sig=b1000...
-  Value cmp0 = icmp_eq(and_(c0, i32_val(0xf800000)), i32_val(0));
-  Value cmp1 = icmp_eq(and_(c1, i32_val(0xf800000)), i32_val(0));
-  Value cmp2 = icmp_eq(and_(c2, i32_val(0xf800000)), i32_val(0));
-  Value cmp3 = icmp_eq(and_(c3, i32_val(0xf800000)), i32_val(0));
-
-  Value predef_idx0 = lshr(and_(c0, i32_val(3 << 21)), i32_val(21));
-  Value predef_idx1 = lshr(and_(c1, i32_val(3 << 21)), i32_val(21));
-  Value predef_idx2 = lshr(and_(c2, i32_val(3 << 21)), i32_val(21));
-  Value predef_idx3 = lshr(and_(c3, i32_val(3 << 21)), i32_val(21));
-
-  Value normalized0 = extract_element(i32_ty, predefined, predef_idx0);
-  Value normalized1 = extract_element(i32_ty, predefined, predef_idx1);
-  Value normalized2 = extract_element(i32_ty, predefined, predef_idx2);
-  Value normalized3 = extract_element(i32_ty, predefined, predef_idx3);
-
-  Value d0 = add(i32_ty, c0, i32_val(0x38000000));
-  Value d1 = add(i32_ty, c1, i32_val(0x38000000));
-  Value d2 = add(i32_ty, c2, i32_val(0x38000000));
-  Value d3 = add(i32_ty, c3, i32_val(0x38000000));
-
-  Value res0 = select(cmp0, normalized0, d0);
-  Value res1 = select(cmp1, normalized1, d1);
-  Value res2 = select(cmp2, normalized2, d2);
-  Value res3 = select(cmp3, normalized3, d3);
-
-  Value f0 = or_(i32_ty, res0, lshr(i32_ty, res1, i32_val(16)));
-  Value f1 = or_(i32_ty, res2, lshr(i32_ty, res3, i32_val(16)));
-
-  Value sign0 = and_(i32_ty, a0, i32_val(0x80008000));
-  Value sign1 = and_(i32_ty, a1, i32_val(0x80008000));
-
-  auto bf16x2VecTy = vec_ty(bf16_ty, 2);
-  Value bf16x2Vec0 = or_(i32_ty, sign0, f0);
-  Value bf16x2Vec1 = or_(i32_ty, sign1, f1);
-  bf16x2Vec0 = bitcast(bf16x2Vec0, bf16x2VecTy);
-  bf16x2Vec1 = bitcast(bf16x2Vec1, bf16x2VecTy);
-
-  return {extract_element(bf16_ty, bf16x2Vec0, i32_val(0)),
-          extract_element(bf16_ty, bf16x2Vec0, i32_val(1)),
-          extract_element(bf16_ty, bf16x2Vec1, i32_val(0)),
-          extract_element(bf16_ty, bf16x2Vec1, i32_val(1))};
+  auto [w0, w1] = packFp8x4ToFp16x2Words(loc, rewriter, v);
+  auto fp16x2VecTy = vec_ty(f16_ty, 2);
+  return unpackFp16x2AsBf16(
+      loc, rewriter, {bitcast(w0, fp16x2VecTy), bitcast(w1, fp16x2VecTy)});
 }
 
 static SmallVector<Value>
@@ -316,48 +295,75 @@ Bf16_to_Fp8E5M2_RTNE_func(Location loc, ConversionPatternRewriter &rewriter,
   return {extract_element(i8_ty, res, i32_val(1))};
 }
 
+/* ----- FP8E5M2FNUZ ------ */
+// This data-type has an exponent bias of 16, no infinities and a single NaN
+// encoded as negative zero (0x80).
+static Value Fp8E5M2FNUZ_to_Fp16x2(Location loc,
+                                   ConversionPatternRewriter &rewriter,
+                                   Value word) {
+  auto i16x2VecTy = vec_ty(i16_ty, 2);
+  auto fp16x2VecTy = vec_ty(f16_ty, 2);
+  Value sign = and_(i32_ty, word, i32_val(0x80008000));
+  Value nosign = bitcast(and_(i32_ty, word, i32_val(0x7f007f00)), i16x2VecTy);
+
+  // Exponents above 1 are rebiased in the integer domain. The remaining values
+  // end up as FP16 subnormals, which are halved exactly by a multiplication.
+  Value normal = sub(i16x2VecTy, nosign,
+                     bitcast(splatI16x2(loc, rewriter, 0x0400), i16x2VecTy));
+  Value subnormal = fmul(
+      fp16x2VecTy, bitcast(nosign, fp16x2VecTy),
+      bitcast(splatI16x2(loc, rewriter, 0x3800 /* 0.5 */), fp16x2VecTy));
+  Value isSubnormal =
+      icmp_ult(nosign, bitcast(splatI16x2(loc, rewriter, 0x0800), i16x2VecTy));
+  Value res = select(isSubnormal, bitcast(subnormal, i16x2VecTy), normal);
+  res = bitcast(or_(i32_ty, bitcast(res, i32_ty), sign), fp16x2VecTy);
+
+  Value isNaN = matchI16x2Lanes(loc, rewriter, word, 0xff00, 0x8000);
+  return select(isNaN, getFp16x2NaN(loc, rewriter), res);
+}
+
+static SmallVector<Value>
+Fp8E5M2FNUZ_to_Fp16_func(Location loc, ConversionPatternRewriter &rewriter,
+                         const SmallVector<Value> &v) {
+  auto [w0, w1] = packFp8x4ToFp16x2Words(loc, rewriter, v);
+  return unpackFp16x2(loc, rewriter,
+                      {Fp8E5M2FNUZ_to_Fp16x2(loc, rewriter, w0),
+                       Fp8E5M2FNUZ_to_Fp16x2(loc, rewriter, w1)});
+}
+
+static SmallVector<Value>
+Fp8E5M2FNUZ_to_Bf16_func(Location loc, ConversionPatternRewriter &rewriter,
+                         const SmallVector<Value> &v) {
+  auto [w0, w1] = packFp8x4ToFp16x2Words(loc, rewriter, v);
+  return unpackFp16x2AsBf16(loc, rewriter,
+                            {Fp8E5M2FNUZ_to_Fp16x2(loc, rewriter, w0),
+                             Fp8E5M2FNUZ_to_Fp16x2(loc, rewriter, w1)});
+}
+
 /* ----- FP8E4M3B15 ------ */
 // This data-type is a variant of the standard FP8E4M3 format.
 // It was designed for fast software conversion to FP16 on GPUs that do not
 // support it natively. Specifically, this data-type:
-//    - has infinities
-//    - has multiple nans (when all exponent bits are 1)
+//    - has no infinities
+//    - has a single nan encoding per sign (S.1111.111)
 //    - has an exponent bias of 15 (vs. 7 for fp8e4m3)
 static SmallVector<Value>
 Fp8E4M3B15_to_Fp16_func(Location loc, ConversionPatternRewriter &rewriter,
                         const SmallVector<Value> &v) {
-  auto fp8x4VecTy = vec_ty(i8_ty, 4);
-  Value a0 = undef(fp8x4VecTy);
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(0));
-  a0 = insert_element(fp8x4VecTy, a0, v[0], i32_val(1));
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(2));
-  a0 = insert_element(fp8x4VecTy, a0, v[1], i32_val(3));
-  a0 = bitcast(a0, i32_ty);
-
-  Value a1 = undef(fp8x4VecTy);
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(0));
-  a1 = insert_element(fp8x4VecTy, a1, v[2], i32_val(1));
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(2));
-  a1 = insert_element(fp8x4VecTy, a1, v[3], i32_val(3));
-  a1 = bitcast(a1, i32_ty);
-
-  Value b0 = and_(i32_ty, a0, i32_val(0x7fff7fff));
-  Value b1 = and_(i32_ty, a1, i32_val(0x7fff7fff));
-
-  b0 = lshr(i32_ty, b0, i32_val(1));
-  b1 = lshr(i32_ty, b1, i32_val(1));
-
-  b0 = or_(i32_ty, b0, and_(i32_ty, a0, i32_val(0x80008000)));
-  b1 = or_(i32_ty, b1, and_(i32_ty, a1, i32_val(0x80008000)));
-
+  auto [w0, w1] = packFp8x4ToFp16x2Words(loc, rewriter, v);
   auto fp16x2VecTy = vec_ty(f16_ty, 2);
-  auto fp16x2Vec0 = bitcast(b0, fp16x2VecTy);
-  auto fp16x2Vec1 = bitcast(b1, fp16x2VecTy);
-
-  return {extract_element(f16_ty, fp16x2Vec0, i32_val(0)),
-          extract_element(f16_ty, fp16x2Vec0, i32_val(1)),
-          extract_element(f16_ty, fp16x2Vec1, i32_val(0)),
-          extract_element(f16_ty, fp16x2Vec1, i32_val(1))};
+  auto cvt = [&](Value word) -> Value {
+    // With the same bias as FP16, shifting exponent and mantissa by one bit
+    // gives the FP16 encoding of normal and subnormal values alike, the
+    // largest exponent included (S.1111.000 to S.1111.110 are finite).
+    Value sign = and_(i32_ty, word, i32_val(0x80008000));
+    Value nosign =
+        lshr(i32_ty, and_(i32_ty, word, i32_val(0x7f007f00)), i32_val(1));
+    Value res = bitcast(or_(i32_ty, sign, nosign), fp16x2VecTy);
+    Value isNaN = matchI16x2Lanes(loc, rewriter, word, 0x7f00, 0x7f00);
+    return select(isNaN, getFp16x2NaN(loc, rewriter), res);
+  };
+  return unpackFp16x2(loc, rewriter, {cvt(w0), cvt(w1)});
 }
 
 static SmallVector<Value>
@@ -485,78 +491,33 @@ Fp16_to_Fp8E4M3B15x4_func(Location loc, ConversionPatternRewriter &rewriter,
 // Note: when handled by software, this format
 // has more than a single NaN values.
 
+// Shifting exponent and mantissa by one bit gives the FP16 encoding of the
+// value scaled by 2^-8 (the difference of the exponent biases), for normal and
+// subnormal values alike. A single packed multiplication restores the exact
+// value. S.1111.111 encodes NaN, there are no infinities.
+static Value Fp8E4M3Nv_to_Fp16x2(Location loc,
+                                 ConversionPatternRewriter &rewriter,
+                                 Value word) {
+  auto fp16x2VecTy = vec_ty(f16_ty, 2);
+  Value sign = and_(i32_ty, word, i32_val(0x80008000));
+  Value nosign =
+      lshr(i32_ty, and_(i32_ty, word, i32_val(0x7f007f00)), i32_val(1));
+  Value res = bitcast(or_(i32_ty, sign, nosign), fp16x2VecTy);
+  res = fmul(fp16x2VecTy, res,
+             bitcast(splatI16x2(loc, rewriter, 0x5c00 /* 256 */), fp16x2VecTy));
+
+  Value isNaN = matchI16x2Lanes(loc, rewriter, word, 0x7f00, 0x7f00);
+  return select(isNaN, getFp16x2NaN(loc, rewriter), res);
+}
+
 // Fp8E4M3 -> Fp16 (packed)
 static SmallVector<Value>
 Fp8E4M3Nv_to_Fp16_func(Location loc, ConversionPatternRewriter &rewriter,
                        const SmallVector<Value> &v) {
-  auto fp8x4VecTy = vec_ty(i8_ty, 4);
-  Value a0 = undef(fp8x4VecTy);
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(0));
-  a0 = insert_element(fp8x4VecTy, a0, v[0], i32_val(1));
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(2));
-  a0 = insert_element(fp8x4VecTy, a0, v[1], i32_val(3));
-  a0 = bitcast(a0, i32_ty);
-
-  Value b0 = and_(i32_ty, a0, i32_val(0x7fff7fff));
-
-  b0 = lshr(i32_ty, b0, i32_val(1));
-
-  Value c0 = and_(i32_ty, b0, i32_val(0xffff0000));
-  Value c1 = shl(i32_ty, b0, i32_val(16));
-
-  // Check if the exponent is zero, i.e. subnormal number.
-  // fp8e4 has a bias of 7
-  // depending on the significand value normalization goes like:
-  //  [000] -> 0x0
-  //  [001] -> exp=15-9, sig=0x0
-  //  [010] -> exp=15-8, sig=0x0
-  //  [011] -> exp=15-8, sig=b100...
-  //  [100] -> exp=15-7, sig=0x0
-  //  [101] -> exp=15-7, sig=b010...
-  //  [110] -> exp=15-7, sig=b100...
-  //  [111] -> exp=15-7, sig=b110...
-  Value cmp0 = icmp_eq(and_(c0, i32_val(0x7c000000)), i32_val(0));
-  Value cmp1 = icmp_eq(and_(c1, i32_val(0x7c000000)), i32_val(0));
-
-  auto i32x8VecTy = vec_ty(i32_ty, 8);
-  Value predefined = undef(i32x8VecTy);
-  predefined = insert_element(i32x8VecTy, predefined, i32_val(0x0), i32_val(0));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x18000000), i32_val(1));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x1C000000), i32_val(2));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x1E000000), i32_val(3));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x20000000), i32_val(4));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x21000000), i32_val(5));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x22000000), i32_val(6));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x23000000), i32_val(7));
-
-  Value predef_idx0 = lshr(and_(c0, i32_val(7 << 23)), i32_val(23));
-  Value predef_idx1 = lshr(and_(c1, i32_val(7 << 23)), i32_val(23));
-
-  Value normalized0 = extract_element(i32_ty, predefined, predef_idx0);
-  Value normalized1 = extract_element(i32_ty, predefined, predef_idx1);
-
-  Value d0 = add(i32_ty, c0, i32_val(0x20000000));
-  Value d1 = add(i32_ty, c1, i32_val(0x20000000));
-
-  Value res0 = select(cmp0, normalized0, d0);
-  Value res1 = select(cmp1, normalized1, d1);
-
-  Value f0 = or_(i32_ty, res0, lshr(i32_ty, res1, i32_val(16)));
-  Value sign0 = and_(i32_ty, a0, i32_val(0x80008000));
-
-  auto fp16x2VecTy = vec_ty(f16_ty, 2);
-  Value fp16x2Vec0 = or_(i32_ty, sign0, f0);
-  fp16x2Vec0 = bitcast(fp16x2Vec0, fp16x2VecTy);
-
-  return {extract_element(f16_ty, fp16x2Vec0, i32_val(0)),
-          extract_element(f16_ty, fp16x2Vec0, i32_val(1))};
+  auto [w0, w1] = packFp8x4ToFp16x2Words(loc, rewriter, v);
+  return unpackFp16x2(loc, rewriter,
+                      {Fp8E4M3Nv_to_Fp16x2(loc, rewriter, w0),
+                       Fp8E4M3Nv_to_Fp16x2(loc, rewriter, w1)});
 }
 
 // Fp16 -> Fp8E4M3 (packed)
@@ -641,101 +602,10 @@ Fp16_to_Fp8E4M3Nv_RTNE_func(Location loc, ConversionPatternRewriter &rewriter,
 static SmallVector<Value>
 Fp8E4M3Nv_to_Bf16_func(Location loc, ConversionPatternRewriter &rewriter,
                        const SmallVector<Value> &v) {
-  auto fp8x4VecTy = vec_ty(i8_ty, 4);
-  Value a0 = undef(fp8x4VecTy);
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(0));
-  a0 = insert_element(fp8x4VecTy, a0, v[0], i32_val(1));
-  a0 = insert_element(fp8x4VecTy, a0, int_val(8, 0), i32_val(2));
-  a0 = insert_element(fp8x4VecTy, a0, v[1], i32_val(3));
-  a0 = bitcast(a0, i32_ty);
-
-  Value a1 = undef(fp8x4VecTy);
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(0));
-  a1 = insert_element(fp8x4VecTy, a1, v[2], i32_val(1));
-  a1 = insert_element(fp8x4VecTy, a1, int_val(8, 0), i32_val(2));
-  a1 = insert_element(fp8x4VecTy, a1, v[3], i32_val(3));
-  a1 = bitcast(a1, i32_ty);
-
-  Value b0 = and_(i32_ty, a0, i32_val(0x7fff7fff));
-  Value b1 = and_(i32_ty, a1, i32_val(0x7fff7fff));
-  b0 = lshr(i32_ty, b0, i32_val(4));
-  b1 = lshr(i32_ty, b1, i32_val(4));
-
-  Value c0 = and_(i32_ty, b0, i32_val(0xffff0000));
-  Value c1 = shl(i32_ty, b0, i32_val(16));
-  Value c2 = and_(i32_ty, b1, i32_val(0xffff0000));
-  Value c3 = shl(i32_ty, b1, i32_val(16));
-
-  // Check if the exponent is zero, i.e. subnormal number.
-  // fp8e4 has a bias of 7
-  // depending on the significand value normalization goes like:
-  //  [000] -> 0x0
-  //  [001] -> exp=127-9, sig=0x0
-  //  [010] -> exp=127-8, sig=0x0
-  //  [011] -> exp=127-8, sig=b1000...
-  //  [100] -> exp=127-7, sig=0x0
-  //  [101] -> exp=127-7, sig=b0100...
-  //  [110] -> exp=127-7, sig=b1000...
-  //  [111] -> exp=127-7, sig=b1100...
-  Value cmp0 = icmp_eq(and_(c0, i32_val(0xf800000)), i32_val(0));
-  Value cmp1 = icmp_eq(and_(c1, i32_val(0xf800000)), i32_val(0));
-  Value cmp2 = icmp_eq(and_(c2, i32_val(0xf800000)), i32_val(0));
-  Value cmp3 = icmp_eq(and_(c3, i32_val(0xf800000)), i32_val(0));
-
-  auto i32x8VecTy = vec_ty(i32_ty, 8);
-  Value predefined = undef(i32x8VecTy);
-  predefined = insert_element(i32x8VecTy, predefined, i32_val(0x0), i32_val(0));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x3B000000), i32_val(1));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x3B800000), i32_val(2));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x3BC00000), i32_val(3));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x3C000000), i32_val(4));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x3C200000), i32_val(5));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x3C400000), i32_val(6));
-  predefined =
-      insert_element(i32x8VecTy, predefined, i32_val(0x3C600000), i32_val(7));
-
-  Value predef_idx0 = lshr(and_(c0, i32_val(7 << 20)), i32_val(20));
-  Value predef_idx1 = lshr(and_(c1, i32_val(7 << 20)), i32_val(20));
-  Value predef_idx2 = lshr(and_(c2, i32_val(7 << 20)), i32_val(20));
-  Value predef_idx3 = lshr(and_(c3, i32_val(7 << 20)), i32_val(20));
-
-  Value normalized0 = extract_element(i32_ty, predefined, predef_idx0);
-  Value normalized1 = extract_element(i32_ty, predefined, predef_idx1);
-  Value normalized2 = extract_element(i32_ty, predefined, predef_idx2);
-  Value normalized3 = extract_element(i32_ty, predefined, predef_idx3);
-
-  Value d0 = add(i32_ty, c0, i32_val(0x3c000000));
-  Value d1 = add(i32_ty, c1, i32_val(0x3c000000));
-  Value d2 = add(i32_ty, c2, i32_val(0x3c000000));
-  Value d3 = add(i32_ty, c3, i32_val(0x3c000000));
-
-  Value res0 = select(cmp0, normalized0, d0);
-  Value res1 = select(cmp1, normalized1, d1);
-  Value res2 = select(cmp2, normalized2, d2);
-  Value res3 = select(cmp3, normalized3, d3);
-
-  Value f0 = or_(i32_ty, res0, lshr(i32_ty, res1, i32_val(16)));
-  Value f1 = or_(i32_ty, res2, lshr(i32_ty, res3, i32_val(16)));
-
-  Value sign0 = and_(i32_ty, a0, i32_val(0x80008000));
-  Value sign1 = and_(i32_ty, a1, i32_val(0x80008000));
-
-  auto bf16x2VecTy = vec_ty(bf16_ty, 2);
-  Value bf16x2Vec0 = or_(i32_ty, sign0, f0);
-  Value bf16x2Vec1 = or_(i32_ty, sign1, f1);
-  bf16x2Vec0 = bitcast(bf16x2Vec0, bf16x2VecTy);
-  bf16x2Vec1 = bitcast(bf16x2Vec1, bf16x2VecTy);
-
-  return {extract_element(bf16_ty, bf16x2Vec0, i32_val(0)),
-          extract_element(bf16_ty, bf16x2Vec0, i32_val(1)),
-          extract_element(bf16_ty, bf16x2Vec1, i32_val(0)),
-          extract_element(bf16_ty, bf16x2Vec1, i32_val(1))};
+  auto [w0, w1] = packFp8x4ToFp16x2Words(loc, rewriter, v);
+  return unpackFp16x2AsBf16(loc, rewriter,
+                            {Fp8E4M3Nv_to_Fp16x2(loc, rewriter, w0),
+                             Fp8E4M3Nv_to_Fp16x2(loc, rewriter, w1)});
 }
 
 static SmallVector<Value>
@@ -1321,6 +1191,7 @@ struct FpToFpOpConversion
     auto F8E4M3B15TyID = TypeID::get<Float8E4M3B11FNUZType>();
     auto F8E4M3TyID = TypeID::get<Float8E4M3FNUZType>();
     auto F8E5M2TyID = TypeID::get<Float8E5M2Type>();
+    auto F8E5M2FNUZTyID = TypeID::get<Float8E5M2FNUZType>();
     auto F8E4M3FNTyID = TypeID::get<Float8E4M3FNType>();
     auto F16TyID = TypeID::get<Float16Type>();
     auto BF16TyID = TypeID::get<BFloat16Type>();
@@ -1343,8 +1214,10 @@ struct FpToFpOpConversion
              {Fp8E4M3B15_to_Fp16_func, 4}},
             {{F8E4M3FNTyID, F16TyID, undefRounding},
              {Fp8E4M3B15x4_to_Fp16_func, 4}},
-            {{F8E4M3TyID, F16TyID, undefRounding}, {Fp8E4M3Nv_to_Fp16_func, 2}},
+            {{F8E4M3TyID, F16TyID, undefRounding}, {Fp8E4M3Nv_to_Fp16_func, 4}},
             {{F8E5M2TyID, F16TyID, undefRounding}, {Fp8E5M2_to_Fp16_func, 4}},
+            {{F8E5M2FNUZTyID, F16TyID, undefRounding},
+             {Fp8E5M2FNUZ_to_Fp16_func, 4}},
             // F16 -> F8
             {{F16TyID, F8E4M3B15TyID, RoundingMode::RTZ},
              {Fp16_to_Fp8E4M3B15_func, 4}},
@@ -1365,6 +1238,8 @@ struct FpToFpOpConversion
             {{F8E5M2TyID, BF16TyID, undefRounding}, {Fp8E5M2_to_Bf16_func, 4}},
             {{F8E4M3TyID, BF16TyID, undefRounding},
              {Fp8E4M3Nv_to_Bf16_func, 4}},
+            {{F8E5M2FNUZTyID, BF16TyID, undefRounding},
+             {Fp8E5M2FNUZ_to_Bf16_func, 4}},
             // BF16 -> F8
             {{BF16TyID, F8E5M2TyID, RoundingMode::RTZ},
              {Bf16_to_Fp8E5M2_func, 4}},
@@ -1,28 +1,14 @@
 #include "PatternTritonGPUOpToLLVM.h"
 #include "Utility.h"
 
+#include "Dialect/TritonIntelGPU/Transforms/Utility.h"
+
 using namespace mlir;
 using namespace mlir::triton;
 
 namespace {
 static int log2Int(int64_t num) { return (num > 1) ? 1 + log2Int(num / 2) : 0; }
 
-static Value generateVoteBallot(Location loc, Value bit, int threadMask,
-                                Value threadId, int numThreadPerWarp,
-                                ConversionPatternRewriter &rewriter) {
-  assert(threadMask == -1 && "unsupported thread mask for TritonGEN target");
-
-  // Emulate vote.ballot.sync behavior using shift, shuffle, and or.
-  // TODO: check for more efficient solution.
-  Value laneId = and_(threadId, i32_val(numThreadPerWarp - 1));
-  Value reduced_val = shl(select(bit, i32_val(1), i32_val(0)), laneId);
-  for (int offs = 1; offs < numThreadPerWarp; offs = offs << 1) {
-    Value other_val = LLVM::intel::shuffleXor(loc, rewriter, reduced_val, offs);
-    reduced_val = or_(reduced_val, other_val);
-  }
-  return reduced_val;
-}
-
 // Compute a histogram within a warp. This uses an algorithm by @apgoucher
 // that does the following:
 // Create a ballot for each bit of the bin index (there
@@ -33,7 +19,8 @@ static SmallVector<Value>
 computeWarpLevelHistogram(Location loc, RankedTensorType srcType,
                           SmallVector<Value> &srcValues, int numBins,
                           int numThreadPerWarp, Value threadId,
-                          ConversionPatternRewriter &rewriter) {
+                          ConversionPatternRewriter &rewriter,
+                          const TargetInfoBase &targetInfo) {
   assert(numBins % numThreadPerWarp == 0 &&
          "numBins must be divisible by numThreadPerWarp");
   Value zero = i32_val(0);
@@ -51,8 +38,8 @@ computeWarpLevelHistogram(Location loc, RankedTensorType srcType,
     SmallVector<Value> ballotBits;
     for (int j = 0; j < numBits; ++j) {
       Value bitSet = and_(value, i32_val(1 << j));
-      Value bit = generateVoteBallot(loc, icmp_ne(bitSet, zero), -1, threadId,
-                                     numThreadPerWarp, rewriter);
+      Value bit = targetInfo.ballot(rewriter, loc, i32_ty,
+                                    icmp_ne(bitSet, zero));
       ballotBits.push_back(bit);
     }
 
@@ -91,6 +78,22 @@ static void atomicAdd(Value ptr, Value val, Location loc,
                                      LLVM::AtomicOrdering::monotonic);
 }
 
+// Waits for the lanes of the sub-group to have completed their accesses to
+// the shared local memory, with the OpenCL `sub_group_barrier` builtin.
+static void subGroupBarrier(Location loc, ConversionPatternRewriter &rewriter) {
+  constexpr unsigned clkLocalMemFence = 0x01;
+  MLIRContext *ctx = rewriter.getContext();
+  Operation *moduleOp = rewriter.getInsertionBlock()
+                            ->getParentOp()
+                            ->getParentWithTrait<OpTrait::SymbolTable>();
+  LLVM::LLVMFuncOp func = triton::gpu::intel::lookupOrCreateSPIRVFn(
+      moduleOp, "_Z17sub_group_barrierj", {i32_ty}, void_ty(ctx));
+  func.setPassthroughAttr(
+      rewriter.getArrayAttr(StringAttr::get(ctx, "convergent")));
+  triton::gpu::intel::createSPIRVBuiltinCall(loc, rewriter, func,
+                                             {i32_val(clkLocalMemFence)});
+}
+
 static SmallVector<Value> computeCrossWarpHistogram(
     Location loc, ConversionPatternRewriter &rewriter, RankedTensorType srcType,
     Value baseSharedMemPtr, const SmallVector<Value> &warpLevelHistogram,
@@ -139,7 +142,12 @@ static SmallVector<Value> computeCrossWarpHistogram(
     rewriter.create<LLVM::BrOp>(loc, afterAtomics);
     rewriter.setInsertionPointToStart(afterAtomics);
   }
-  barrier();
+  // With a single warp the work-group is a single sub-group: its lanes only
+  // need to wait for each other before reading back the histogram.
+  if (numWarps > 1)
+    barrier();
+  else
+    subGroupBarrier(loc, rewriter);
   // load the histogram to register with the right layout.
   for (Value index : indices) {
     Value sharedMemPtr =
@@ -183,12 +191,13 @@ public:
     // First compute a warp local histogram based on values owned by each warps.
     SmallVector<Value> warpLevelHistogram =
         computeWarpLevelHistogram(loc, srcType, srcValues, numBins,
-                                  numThreadsPerWarp, threadId, rewriter);
+                                  numThreadsPerWarp, threadId, rewriter,
+                                  targetInfo);
 
     // Then use atomic to update the histogram in shared memory.
-    // TODO: we could skip this for cases with num_warps=1 as long as we can
-    // generate the right layout. Currently the warp level histogram generates
-    // data in the default blocked layout.
+    // TODO: we could skip the shared memory round trip for cases with
+    // num_warps=1 as long as we can generate the right layout. Currently the
+    // warp level histogram generates data in the default blocked layout.
     Value baseSharedMemPtr =
         LLVM::intel::getSharedMemoryBase(loc, rewriter, op.getOperation());
     auto dstType = op.getType();
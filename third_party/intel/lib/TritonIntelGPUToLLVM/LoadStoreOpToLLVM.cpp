@@ -133,18 +133,32 @@ getValuesFromBlockPointerStruct(Value blockPointerStruct,
   return values;
 }
 
+/// Return true if the block pointer \p ptr is column-major, i.e. if its first
+/// dimension is the contiguous one in memory.
+bool isColumnMajor(Value ptr) {
+  MakeTensorPtrOp makeTensorPtrOp = getMakeTensorPtrOp(ptr);
+  ArrayRef<int32_t> order = makeTensorPtrOp.getOrder();
+  return order.size() == 2 && order[0] == 0;
+}
+
 /// Compute the 2D prefetch shape for each warp given an input 2D tensor.
-/// Because a cache line is 64 bytes, and we want to prefetch one cache line a
-/// time (per thread), the maximum number of bytes per column is 64. We know
-/// that the maximum size for each 2D prefetch is 2048 bytes, therefore the
-/// maximum number of rows is given by 2048/64=32.
-SmallVector<unsigned, 2> get2DPrefetchShapePerWarp(RankedTensorType tensorTy) {
+/// Each row of a prefetch covers the widest row of a 2D block access of the
+/// target (64 bytes, i.e. a cache line, on PVC), and the number of rows is
+/// bounded by both the maximum height of a block and the maximum size of a
+/// block access (2048 bytes on PVC, i.e. 2048/64=32 rows).
+SmallVector<unsigned, 2>
+get2DPrefetchShapePerWarp(RankedTensorType tensorTy,
+                          const TargetArchNativeSizes &nativeSizes) {
   Type eltTy = tensorTy.getElementType();
   const ArrayRef<int64_t> tensorShape = tensorTy.getShape();
   unsigned elemSizeInBits = eltTy.getIntOrFloatBitWidth();
   unsigned elemSizeInBytes = elemSizeInBits / 8;
-  unsigned maxBytesPerCol = 64;
-  unsigned numRows = std::min<unsigned>(tensorShape[0], 32);
+  unsigned maxBytesPerCol = nativeSizes.getMaxBlockRowBytes();
+  assert(maxBytesPerCol && "target does not support 2D block accesses");
+  unsigned maxRows = std::min(nativeSizes.getMaxBlockHeight(),
+                              nativeSizes.getLoadStoreSize() * 4 /
+                                  maxBytesPerCol);
+  unsigned numRows = std::min<unsigned>(tensorShape[0], maxRows);
   unsigned numCols = maxBytesPerCol / elemSizeInBytes;
   return {numRows, numCols};
 }
@@ -178,6 +192,145 @@ getWarpsPerCTA(const ArrayRef<int64_t> tensorShape,
   return warpsPerCTA;
 }
 
+/// Map the cache modifier and eviction policy of a load to the LSC cache
+/// controls. The L1 behavior follows the cache modifier (`.ca` caches, `.cg`
+/// bypasses the L1 and `.cs` streams), while the L3 behavior follows the
+/// eviction policy: data marked as evicted first (or streamed) is not kept in
+/// the L3.
+TritonGEN::LoadCacheControl getLoadCacheControl(triton::CacheModifier cache,
+                                                triton::EvictionPolicy evict) {
+  using TritonGEN::LoadCacheControl;
+  if (cache == triton::CacheModifier::NONE &&
+      evict == triton::EvictionPolicy::NORMAL)
+    return LoadCacheControl::DEFAULT;
+
+  bool l3Uncached = evict == triton::EvictionPolicy::EVICT_FIRST ||
+                    (cache == triton::CacheModifier::CS &&
+                     evict != triton::EvictionPolicy::EVICT_LAST);
+  switch (cache) {
+  case triton::CacheModifier::CG:
+    return l3Uncached ? LoadCacheControl::L1UC_L3UC
+                      : LoadCacheControl::L1UC_L3C;
+  case triton::CacheModifier::CS:
+    return l3Uncached ? LoadCacheControl::L1S_L3UC : LoadCacheControl::L1S_L3C;
+  default:
+    return l3Uncached ? LoadCacheControl::L1C_L3UC : LoadCacheControl::L1C_L3C;
+  }
+}
+
+/// Map the cache modifier and eviction policy of a store to the LSC cache
+/// controls. There is no write-back L1 with uncached L3 control, such stores
+/// are written through the L1 instead.
+TritonGEN::StoreCacheControl
+getStoreCacheControl(triton::CacheModifier cache,
+                     triton::EvictionPolicy evict) {
+  using TritonGEN::StoreCacheControl;
+  if (cache == triton::CacheModifier::NONE &&
+      evict == triton::EvictionPolicy::NORMAL)
+    return StoreCacheControl::DEFAULT;
+
+  bool l3Uncached = evict == triton::EvictionPolicy::EVICT_FIRST ||
+                    (cache == triton::CacheModifier::CS &&
+                     evict != triton::EvictionPolicy::EVICT_LAST);
+  switch (cache) {
+  case triton::CacheModifier::CG:
+    return l3Uncached ? StoreCacheControl::L1UC_L3UC
+                      : StoreCacheControl::L1UC_L3WB;
+  case triton::CacheModifier::CS:
+    return l3Uncached ? StoreCacheControl::L1S_L3UC
+                      : StoreCacheControl::L1S_L3WB;
+  case triton::CacheModifier::WT:
+    return l3Uncached ? StoreCacheControl::L1WT_L3UC
+                      : StoreCacheControl::L1WT_L3WB;
+  default:
+    return l3Uncached ? StoreCacheControl::L1WT_L3UC
+                      : StoreCacheControl::L1WB_L3WB;
+  }
+}
+
+/// Return the cache control decoration to attach to a scattered memory
+/// operation accessing the pointer operand \p operandNum, or a null attribute
+/// if \p cacheControl is the default one.
+TritonGEN::DecorationCacheControlAttr
+getCacheControlsDecoration(MLIRContext *ctx,
+                           TritonGEN::LoadCacheControl cacheControl,
+                           unsigned operandNum) {
+  using TritonGEN::LoadCacheControl;
+  using Decoration = TritonGEN::LoadCacheControlDecorationEnum;
+  std::pair<Decoration, Decoration> levels;
+  switch (cacheControl) {
+  case LoadCacheControl::DEFAULT:
+    return {};
+  case LoadCacheControl::L1UC_L3UC:
+    levels = {Decoration::Uncached, Decoration::Uncached};
+    break;
+  case LoadCacheControl::L1UC_L3C:
+    levels = {Decoration::Uncached, Decoration::Cached};
+    break;
+  case LoadCacheControl::L1C_L3UC:
+    levels = {Decoration::Cached, Decoration::Uncached};
+    break;
+  case LoadCacheControl::L1C_L3C:
+    levels = {Decoration::Cached, Decoration::Cached};
+    break;
+  case LoadCacheControl::L1S_L3UC:
+    levels = {Decoration::Streaming, Decoration::Uncached};
+    break;
+  case LoadCacheControl::L1S_L3C:
+    levels = {Decoration::Streaming, Decoration::Cached};
+    break;
+  case LoadCacheControl::L1IAR_L3C:
+    levels = {Decoration::InvalidateAfterRead, Decoration::Cached};
+    break;
+  }
+  SmallVector<Attribute, 2> decorations{
+      TritonGEN::LoadCacheControlDecorationAttr::get(ctx, 0, levels.first,
+                                                     operandNum),
+      TritonGEN::LoadCacheControlDecorationAttr::get(ctx, 1, levels.second,
+                                                     operandNum)};
+  return TritonGEN::DecorationCacheControlAttr::get(ctx, decorations);
+}
+
+TritonGEN::DecorationCacheControlAttr
+getCacheControlsDecoration(MLIRContext *ctx,
+                           TritonGEN::StoreCacheControl cacheControl,
+                           unsigned operandNum) {
+  using TritonGEN::StoreCacheControl;
+  using Decoration = TritonGEN::StoreCacheControlDecorationEnum;
+  std::pair<Decoration, Decoration> levels;
+  switch (cacheControl) {
+  case StoreCacheControl::DEFAULT:
+    return {};
+  case StoreCacheControl::L1UC_L3UC:
+    levels = {Decoration::Uncached, Decoration::Uncached};
+    break;
+  case StoreCacheControl::L1UC_L3WB:
+    levels = {Decoration::Uncached, Decoration::WriteBack};
+    break;
+  case StoreCacheControl::L1WT_L3UC:
+    levels = {Decoration::WriteThrough, Decoration::Uncached};
+    break;
+  case StoreCacheControl::L1WT_L3WB:
+    levels = {Decoration::WriteThrough, Decoration::WriteBack};
+    break;
+  case StoreCacheControl::L1S_L3UC:
+    levels = {Decoration::Streaming, Decoration::Uncached};
+    break;
+  case StoreCacheControl::L1S_L3WB:
+    levels = {Decoration::Streaming, Decoration::WriteBack};
+    break;
+  case StoreCacheControl::L1WB_L3WB:
+    levels = {Decoration::WriteBack, Decoration::WriteBack};
+    break;
+  }
+  SmallVector<Attribute, 2> decorations{
+      TritonGEN::StoreCacheControlDecorationAttr::get(ctx, 0, levels.first,
+                                                      operandNum),
+      TritonGEN::StoreCacheControlDecorationAttr::get(ctx, 1, levels.second,
+                                                      operandNum)};
+  return TritonGEN::DecorationCacheControlAttr::get(ctx, decorations);
+}
+
 // Contains some helper functions for both Load and Store conversions.
 struct LoadStoreConversionBase {
   explicit LoadStoreConversionBase(const triton::intel::TargetInfo &targetInfo,
@@ -245,12 +398,19 @@ struct PrefetchOpConversion
     auto ptrType = cast<PointerType>(ptr.getType());
     auto tensorType = cast<RankedTensorType>(ptrType.getPointeeType());
     Type eltTy = tensorType.getElementType();
-    const ArrayRef<int64_t> tensorShape = tensorType.getShape();
+    SmallVector<int64_t> tensorShape(tensorType.getShape());
+
+    // A column-major block is prefetched as its row-major transpose.
+    bool columnMajor = isColumnMajor(ptr);
+    if (columnMajor) {
+      std::swap(tensorShape[0], tensorShape[1]);
+      tensorType = RankedTensorType::get(tensorShape, eltTy);
+    }
 
     unsigned numWarps = triton::gpu::TritonGPUDialect::getNumWarps(mod);
 
-    SmallVector<unsigned, 2> shapePerWarp =
-        get2DPrefetchShapePerWarp(tensorType);
+    SmallVector<unsigned, 2> shapePerWarp = get2DPrefetchShapePerWarp(
+        tensorType, getTargetArchNativeSizes(mod));
     SmallVector<unsigned, 2> warpsPerCTA =
         getWarpsPerCTA(tensorShape, shapePerWarp, numWarps);
 
@@ -273,6 +433,11 @@ struct PrefetchOpConversion
     auto [base, baseWidth, baseHeight, rowStride, colStride, offsetBaseX,
           offsetBaseY] =
         getValuesFromBlockPointerStruct(adaptor.getPtr(), rewriter);
+    if (columnMajor) {
+      std::swap(baseWidth, baseHeight);
+      std::swap(rowStride, colStride);
+      std::swap(offsetBaseX, offsetBaseY);
+    }
 
     base = gep(base.getType(), eltTy, base, offsetBaseX);
     offsetBaseY = trunc(i32_ty, offsetBaseY);
@@ -289,6 +454,13 @@ struct PrefetchOpConversion
     multiDimWarpId[1] = trunc(i32_ty, multiDimWarpId[1]);
     multiDimWarpId[0] = trunc(i32_ty, multiDimWarpId[0]);
 
+    // Prefetches are cached in both L1 and L3 unless the prefetched load
+    // requests otherwise.
+    TritonGEN::LoadCacheControl cacheControl =
+        getLoadCacheControl(op.getCache(), op.getEvict());
+    if (cacheControl == TritonGEN::LoadCacheControl::DEFAULT)
+      cacheControl = TritonGEN::LoadCacheControl::L1C_L3C;
+
     for (int row = 0; row < numReps[0]; ++row) {
       for (int col = 0; col < numReps[1]; ++col) {
         Value offsetX, offsetY;
@@ -320,7 +492,7 @@ struct PrefetchOpConversion
             /*v_blocks*/ 1,
             /*transpose*/ false,
             /*vnni_transform*/ false,
-            /*cache_opt*/ TritonGEN::LoadCacheControl::L1C_L3C);
+            /*cache_opt*/ cacheControl);
       }
     }
 
@@ -388,8 +560,13 @@ struct LoadOpConversion
     // pack scalars for operand A and B.
     Type elemType = (isOperandA && eltTy != f32_ty) ? i16_ty : i32_ty;
     unsigned opsPerChannel = dpasLayout.getOpsPerChannel();
+    unsigned elemSizeInBits = eltTy.getIntOrFloatBitWidth();
+    // Operand B is read with the VNNI transform, which packs consecutive rows
+    // of a column into dwords. This yields the elements of each work item in
+    // the order of the DPAS layout even when they are narrower than the DPAS
+    // channel, e.g. 8 bit weights dequantized to a 16 bit DPAS type.
     elemsPerLane = isOperandA ? elemsPerLane / (opsPerChannel == 4 ? 2 : 1)
-                              : elemsPerLane / opsPerChannel;
+                              : elemsPerLane * elemSizeInBits / 32;
     Type load2DGenXType = LLVM::getFixedVectorType(elemType, elemsPerLane);
 
     // Outer dim for A is the M, for B is the N. Inner dim for both is the K.
@@ -402,6 +579,24 @@ struct LoadOpConversion
           offsetBaseY] =
         getValuesFromBlockPointerStruct(adaptor.getPtr(), rewriter);
 
+    // A column-major operand is stored in memory as the row-major transpose of
+    // the tile. Pairs of 16 bit elements are loaded as 32 bit elements with the
+    // transposed 2D block read, which directly yields the DPAS layout: one row
+    // per work item for operand A and the VNNI packed layout for operand B.
+    const bool columnMajor = isColumnMajor(ptr);
+    if (columnMajor) {
+      assert(elemSizeInBits == 16 &&
+             "Only 16 bit column-major block pointers are supported");
+      std::swap(baseWidth, baseHeight);
+      rowStride = colStride;
+      load2DGenXType = LLVM::getFixedVectorType(
+          i32_ty, product<int64_t>(elemsPerInstr) * elemSizeInBits /
+                      (32 * threadsPerWarp));
+    }
+
+    TritonGEN::LoadCacheControl cacheControl =
+        getLoadCacheControl(op.getCache(), op.getEvict());
+
     // Load the operand.
     int64_t numRepOuter = numReps[opIdx];
     int64_t numRepK = numReps[!opIdx];
@@ -426,9 +621,31 @@ struct LoadOpConversion
         baseHeight = trunc(i32_ty, baseHeight);
         rowStride = trunc(i32_ty, rowStride);
 
-        unsigned elemSizeInBits = eltTy.getIntOrFloatBitWidth();
         Value elemSizeInBytes = i32_val(elemSizeInBits / 8);
 
+        if (columnMajor) {
+          // The x coordinate is expressed in (32 bit) elements of the
+          // transposed tile.
+          auto load2dOp = rewriter.create<TritonGEN::Matrix2DBlockLoadOp>(
+              loc, load2DGenXType,
+              /*ptr*/ base,
+              /*base_width*/ mul(baseWidth, elemSizeInBytes),
+              /*base_height*/ baseHeight,
+              /*base_pitch*/ mul(rowStride, elemSizeInBytes),
+              /*x*/ trunc(i32_ty, udiv(offsetY, i32_val(2))),
+              /*y*/ trunc(i32_ty, offsetX),
+              /*elem_size_in_bits*/ 32,
+              /*tile_width*/ elemsPerInstr[0] / 2,
+              /*tile_height*/ elemsPerInstr[1],
+              /*v_blocks*/ 1,
+              /*transpose*/ true,
+              /*vnni_transform*/ false,
+              /*cache_control*/ cacheControl);
+
+          rets.push_back(bitcast(load2dOp, unpackType));
+          continue;
+        }
+
         auto load2dOp = rewriter.create<TritonGEN::Matrix2DBlockLoadOp>(
             loc, load2DGenXType,
             /*ptr*/ base,
@@ -443,7 +660,8 @@ struct LoadOpConversion
             /*v_blocks*/ 1,
             /*transpose*/ false,
             /*vnni_transform*/
-            (!isOperandA && eltTy.getIntOrFloatBitWidth() != 32));
+            (!isOperandA && eltTy.getIntOrFloatBitWidth() != 32),
+            /*cache_control*/ cacheControl);
 
         rets.push_back(bitcast(load2dOp, unpackType));
       }
@@ -530,6 +748,12 @@ struct LoadOpConversion
         std::max(8u, valueElemTy.getIntOrFloatBitWidth());
     const int numVecs = numElems / vec;
 
+    // The pointer is the only operand of `llvm.load`.
+    TritonGEN::DecorationCacheControlAttr cacheControls =
+        getCacheControlsDecoration(
+            ctx, getLoadCacheControl(op.getCache(), op.getEvict()),
+            /*operandNum*/ 0);
+
     SmallVector<Value> loadedVals;
     for (size_t vecStart = 0; vecStart < numElems; vecStart += vec) {
       // TODO: optimization when ptr is GEP with constant offset
@@ -590,8 +814,12 @@ struct LoadOpConversion
             Value addrElem =
                 bitcast(ptrElems[vecStart], ptr_ty(ctx, 1 /*global*/));
             uint32_t alignment = nWords * width / 8;
-            Value ret = load(retTy, addrElem, alignment);
-            return SmallVector<Value, 1>{ret};
+            auto loadOp = load(retTy, addrElem, alignment);
+            if (cacheControls)
+              loadOp->setAttr(
+                  TritonGEN::TritonGENDialect::getCacheControlsAttrName(),
+                  cacheControls);
+            return SmallVector<Value, 1>{loadOp.getResult()};
           });
       Value ret = *endBlock.args_begin();
 
@@ -691,24 +919,40 @@ struct StoreOpConversion
     // encoded as bytes.
     Value basePitch = mul(rowStride, elemSizeInBytes);
 
-    // A dense stride for the replicates.
+    // The replicates of the DPAS layout are strided by the CTA tile, the warps
+    // own consecutive tiles within it.
     std::array<unsigned, 2> replicaStride = {
+        static_cast<unsigned>(warpsPerCTA[0] * elemsPerInstr[0]),
+        static_cast<unsigned>(warpsPerCTA[1] * elemsPerInstr[1])};
+    std::array<unsigned, 2> warpStride = {
         static_cast<unsigned>(elemsPerInstr[0]),
         static_cast<unsigned>(elemsPerInstr[1])};
-    std::array<unsigned, 2> warpStride = {
-        static_cast<unsigned>(numReps[0] * elemsPerInstr[0]),
-        static_cast<unsigned>(numReps[1] * elemsPerInstr[1])};
 
-    Value dimWarpId0 = mul(multiDimWarpId[0], i32_val(warpStride[0]));
-    Value dimWarpId1 = mul(multiDimWarpId[1], i32_val(warpStride[1]));
+    // When the tensor is smaller than the CTA tile the data is replicated
+    // across warps, wrap the warp id so that the replicas write the same tile
+    // instead of writing past the tensor block.
+    SmallVector<Value> uniqueWarpId(2);
+    for (unsigned dim = 0; dim < 2; ++dim) {
+      unsigned numWarpsWithUniqueData = std::min<unsigned>(
+          warpsPerCTA[dim], ceil<unsigned>(tensorShape[dim], warpStride[dim]));
+      uniqueWarpId[dim] =
+          urem(multiDimWarpId[dim], i32_val(numWarpsWithUniqueData));
+    }
+
+    Value dimWarpId0 = mul(uniqueWarpId[0], i32_val(warpStride[0]));
+    Value dimWarpId1 = mul(uniqueWarpId[1], i32_val(warpStride[1]));
     Value warpId0Offset = add(dimWarpId0, offsetBaseY);
     Value warpId1Offset = add(dimWarpId1, offsetBaseX);
+    TritonGEN::StoreCacheControl cacheControl =
+        getStoreCacheControl(op.getCache(), op.getEvict());
     unsigned valOffset = 0;
     for (int m = 0; m < numReps[0]; ++m) {
       Value offsetY = add(warpId0Offset, i32_val(m * replicaStride[0]));
       for (int n = 0; n < numReps[1]; ++n) {
         Value offsetX = add(warpId1Offset, i32_val(n * replicaStride[1]));
 
+        // Out of bounds elements of the tile are dropped by the 2D block
+        // store, so no masking is needed at the boundary of the matrix.
         Value storeVal = rewriter.create<LLVM::UndefOp>(
             loc, LLVM::getFixedVectorType(typeConverter->convertType(eltTy),
                                           elemsPerLane));
@@ -731,7 +975,8 @@ struct StoreOpConversion
             /*v_blocks*/ 1,
             /*transpose*/ false,
             /*vnni_transform*/ false,
-            /*stored_val*/ bitcast(storeVal, store2DGenXType));
+            /*stored_val*/ bitcast(storeVal, store2DGenXType),
+            /*cache_control*/ cacheControl);
       }
     }
     rewriter.eraseOp(op);
@@ -781,6 +1026,12 @@ struct StoreOpConversion
         std::max<int>(1, valueElemTy.getIntOrFloatBitWidth() / 8);
     const size_t valueElemNBits = dtsize * 8;
 
+    // The pointer is the second operand of `llvm.store`.
+    TritonGEN::DecorationCacheControlAttr cacheControls =
+        getCacheControlsDecoration(
+            ctx, getStoreCacheControl(op.getCache(), op.getEvict()),
+            /*operandNum*/ 1);
+
     const int numVecs = elemsPerThread / vec;
     for (size_t vecStart = 0; vecStart < elemsPerThread; vecStart += vec) {
       // TODO: optimization when ptr is AddPtr with constant offset
@@ -793,9 +1044,6 @@ struct StoreOpConversion
       const size_t wordNElems = width / valueElemNBits;
       assert(wordNElems * nWords * numVecs == elemsPerThread);
 
-      // TODO(Superjomn) Add cache policy fields to StoreOp.
-      // TODO(Superjomn) Deal with cache policy here.
-
       Type valArgTy = IntegerType::get(ctx, width);
       auto wordTy = vec_ty(valueElemTy, wordNElems);
 
@@ -833,7 +1081,11 @@ struct StoreOpConversion
       LLVM::intel::createPredicatedBlock(rewriter, loc, maskVal, [&] {
         Value addrElem = bitcast(ptrElems[vecStart], ptr_ty(ctx, 1 /*global*/));
         uint32_t alignment = nWords * width / 8;
-        store(vecWord, addrElem, alignment);
+        auto storeOp = store(vecWord, addrElem, alignment);
+        if (cacheControls)
+          storeOp->setAttr(
+              TritonGEN::TritonGENDialect::getCacheControlsAttrName(),
+              cacheControls);
         return ArrayRef<Value>();
       });
     } // for
@@ -184,10 +184,6 @@ public:
             !mod->hasAttr("triton_gpu.is_lts") &&
             mlir::triton::tools::getBoolEnv("TRITON_INTEL_ENABLE_BLOCK_PTR")) {}
 
-  /// FIXME: remove once the block ptr conversion path is capable of handling
-  ///        shared memory.
-  bool skipSharedMemoryAllocation() const { return blockPtrPathIsEnabled; }
-
   /// Populate the conversion pipeline for function operations.
   void populateFunctionConversionPatterns(
       RewritePatternSet &funcPatterns,
@@ -17,8 +17,14 @@ namespace mlir::triton::intel {
 bool TargetInfo::supportMaximumMinimum() const { return true; }
 Value TargetInfo::ballot(ConversionPatternRewriter &rewriter, Location loc,
                          Type type, Value cmp) const {
-  assert("TODO: implement ballot on XPU");
-  return Value();
+  assert(cmp.getType().isInteger(1) && "Expecting an i1 predicate");
+  Value ballot = rewriter.create<TritonGEN::SubGroupBallotOp>(loc, i32_ty, cmp);
+  unsigned bitWidth = type.getIntOrFloatBitWidth();
+  if (bitWidth > 32)
+    return zext(type, ballot);
+  if (bitWidth < 32)
+    return trunc(type, ballot);
+  return ballot;
 }
 
 Value TargetInfo::getClusterCTAId(RewriterBase &rewriter, Location loc) const {
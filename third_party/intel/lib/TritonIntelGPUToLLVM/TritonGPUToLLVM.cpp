@@ -88,7 +88,7 @@ struct ConvertTritonGPUToLLVM
     int threadsPerWarp = triton::gpu::TritonGPUDialect::getThreadsPerWarp(mod);
 
     // Allocate shared memory and set barrier
-    if (!pipelineManager.skipSharedMemoryAllocation()) {
+    {
       ModuleAllocation allocation(mod);
       ModuleMembarAnalysis membarPass(&allocation);
       membarPass.run();
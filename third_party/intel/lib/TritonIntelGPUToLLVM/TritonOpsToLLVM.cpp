@@ -20,6 +20,44 @@ VectorType getVectorType(RankedTensorType tensorType, Type elemType) {
   return vec_ty(elemType, num);
 };
 
+/// Returns the width of the 2D blocks used to access `tensorType` and the
+/// number of such blocks (placed side by side) covering the tensor.
+std::pair<unsigned, unsigned>
+getBlockWidthAndNumBlocks(RankedTensorType tensorType, IntegerAttr idxAttr) {
+  unsigned dataSize = tensorType.getElementTypeBitWidth();
+  unsigned blockWidth = tensorType.getShape()[1];
+  assert((blockWidth == 8 || blockWidth == 16 || blockWidth == 32 ||
+          blockWidth == 64) &&
+         "only support 8/16/32/64 block");
+  unsigned vBlks = 1;
+  if (dataSize == 16) {
+    vBlks = ceil(blockWidth, 16U);
+    blockWidth = 16;
+  } else if (dataSize == 8 && idxAttr) {
+    unsigned blockWidthUnit = idxAttr.getInt() == 0 ? 32 : 16;
+    vBlks = ceil(blockWidth, blockWidthUnit);
+    blockWidth = blockWidthUnit;
+  }
+  assert((vBlks == 1 || vBlks == 2) && "only support 1 or 2 blocks");
+  return {blockWidth, vBlks};
+}
+
+/// Replaces the allocation by a pointer to its offset in the shared local
+/// memory of the kernel.
+class AllocOpConversion : public ConvertTritonGPUOpToLLVMPattern<AllocOp> {
+public:
+  using ConvertTritonGPUOpToLLVMPattern<
+      AllocOp>::ConvertTritonGPUOpToLLVMPattern;
+  LogicalResult
+  matchAndRewrite(AllocOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+    rewriter.replaceOp(op,
+                       LLVM::intel::getSharedMemoryBase(loc, rewriter, op));
+    return success();
+  }
+};
+
 /// v2i32 [offsetX, offsetY] for 2D tensor desc.
 class MakeTensorPtrOpConversion
     : public ConvertTritonGPUOpToLLVMPattern<MakeTensorPtrOp> {
@@ -125,21 +163,8 @@ public:
     Type elemType = tensorType.getElementType();
     unsigned dataSize = elemType.getIntOrFloatBitWidth();
     unsigned blockHeight = tensorType.getShape()[0];
-    unsigned blockWidth = tensorType.getShape()[1];
-    assert((blockWidth == 8 || blockWidth == 16 || blockWidth == 32 ||
-            blockWidth == 64) &&
-           "only support 8/16/32/64 block");
     auto idxAttr = op->template getAttrOfType<mlir::IntegerAttr>("DotIdx");
-    unsigned vBlks = 1;
-    if (dataSize == 16) {
-      vBlks = ceil(blockWidth, 16U);
-      blockWidth = 16;
-    } else if (dataSize == 8 && idxAttr) {
-      unsigned blockWidthUnit = idxAttr.getInt() == 0 ? 32 : 16;
-      vBlks = ceil(blockWidth, blockWidthUnit);
-      blockWidth = blockWidthUnit;
-    }
-    assert((vBlks == 1 || vBlks == 2) && "only support 1 or 2 blocks");
+    auto [blockWidth, vBlks] = getBlockWidthAndNumBlocks(tensorType, idxAttr);
 
     Value ptr = op.getPtr();
     if (auto cast =
@@ -209,6 +234,111 @@ public:
   }
 };
 
+/// Loads/stores through a block pointer in shared local memory. 2D block
+/// operations can only access global memory, so the accesses are emulated
+/// with one scalar access per element, using the same distribution of the
+/// tensor elements across the 16 subgroup lanes as the 2D block operations:
+/// element `i` of the vector of lane `l` holds element (row, col) of the
+/// tensor, with:
+///   i = blk * (blockHeight * blockWidth / 16) + row * (blockWidth / 16) + c
+///   col = blk * blockWidth + c * 16 + l
+/// The loads of DPAS B operands narrower than 32 bits reproduce the VNNI
+/// transform of the 2D block loads, which packs the `pack = 32 / dataSize`
+/// consecutive rows of a column into a dword:
+///   i = blk * (blockHeight * blockWidth / 16) +
+///       ((row / pack) * (blockWidth / 16) + c) * pack + row % pack
+template <typename OpType, typename = std::enable_if_t<llvm::is_one_of<
+                               OpType, LoadOp, StoreOp>::value>>
+class SharedMemoryLoadStoreOpConversion
+    : public ConvertTritonGPUOpToLLVMPattern<OpType> {
+public:
+  using ConvertTritonGPUOpToLLVMPattern<
+      OpType>::ConvertTritonGPUOpToLLVMPattern;
+  LogicalResult
+  matchAndRewrite(OpType op, typename OpType::Adaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto ptrType = cast<PointerType>(op.getPtr().getType());
+    if (ptrType.getAddressSpace() !=
+        TritonGEN::TritonGENMemorySpace::kWorkgroup)
+      return failure();
+
+    auto tensorType = cast<RankedTensorType>(ptrType.getPointeeType());
+    assert(tensorType.getRank() == 2 && "only support 2d load/store for now");
+
+    Type elemType = tensorType.getElementType();
+    unsigned dataSize = elemType.getIntOrFloatBitWidth();
+    unsigned blockHeight = tensorType.getShape()[0];
+    auto idxAttr = op->template getAttrOfType<mlir::IntegerAttr>("DotIdx");
+    auto [blockWidth, vBlks] = getBlockWidthAndNumBlocks(tensorType, idxAttr);
+
+    Value ptr = op.getPtr();
+    if (auto cast =
+            dyn_cast<mlir::UnrealizedConversionCastOp>(ptr.getDefiningOp()))
+      ptr = cast.getInputs()[0];
+
+    MakeTensorPtrOp ptrOp = getMakeTensorPtrOp(ptr);
+    Value base = rewriter.getRemappedValue(ptrOp.getBase());
+
+    OpBuilder::InsertPoint insertPoint = rewriter.saveInsertionPoint();
+    rewriter.setInsertionPointAfter(ptrOp);
+    Location loc = op.getLoc();
+    Value pitch = trunc(i32_ty, ptrOp.getStrides()[0]);
+    rewriter.restoreInsertionPoint(insertPoint);
+
+    Value tensorPtr = adaptor.getPtr();
+    Value offsetX = extract_element(tensorPtr, i32_val(0));
+    Value offsetY = extract_element(tensorPtr, i32_val(1));
+    Value laneId = urem(getThreadId(rewriter, loc), i32_val(16));
+
+    Type intType = rewriter.getIntegerType(dataSize);
+    unsigned numChunks = blockWidth / 16;
+    unsigned numElems = vBlks * blockHeight * numChunks;
+    bool vnni = std::is_same_v<OpType, LoadOp> && idxAttr &&
+                idxAttr.getInt() == 1 && dataSize < 32;
+    unsigned packSize = vnni ? 32 / dataSize : 1;
+    assert(blockHeight % packSize == 0 &&
+           "VNNI packed rows must not cross the block height");
+    VectorType vectorType = vec_ty(intType, numElems);
+    Type llvmPtrType = ptr_ty(rewriter.getContext(),
+                              TritonGEN::TritonGENMemorySpace::kWorkgroup);
+
+    Value storedVal;
+    if constexpr (std::is_same_v<OpType, StoreOp>)
+      storedVal = bitcast(adaptor.getValue(), vectorType);
+    Value loadedVal = undef(vectorType);
+
+    for (unsigned blk = 0; blk < vBlks; ++blk) {
+      for (unsigned row = 0; row < blockHeight; ++row) {
+        Value rowOffset = mul(add(offsetY, i32_val(row)), pitch);
+        for (unsigned c = 0; c < numChunks; ++c) {
+          unsigned idx = blk * blockHeight * numChunks +
+                         ((row / packSize) * numChunks + c) * packSize +
+                         row % packSize;
+          unsigned colOffset = blk * blockWidth + c * 16;
+          Value col = add(offsetX, add(laneId, i32_val(colOffset)));
+          Value elemPtr = gep(llvmPtrType, intType, base, add(rowOffset, col));
+          if constexpr (std::is_same_v<OpType, LoadOp>) {
+            Value elem = load(intType, elemPtr);
+            loadedVal = insert_element(loadedVal, elem, i32_val(idx));
+          } else {
+            store(extract_element(storedVal, i32_val(idx)), elemPtr);
+          }
+        }
+      }
+    }
+
+    if constexpr (std::is_same_v<OpType, LoadOp>) {
+      Type resType =
+          this->getTypeConverter()->convertType(op->getResult(0).getType());
+      rewriter.replaceOp(op, bitcast(loadedVal, resType));
+    } else {
+      rewriter.eraseOp(op);
+    }
+
+    return success();
+  }
+};
+
 /// TritonGen DpasOp Desc: XeHP SDV: dot product accumulate systolic
 /// Output: dst
 /// Arg 0: src0(acc)
@@ -346,6 +476,7 @@ public:
 void mlir::triton::intel::populateTritonOpsToLLVMPatterns(
     TritonIntelGPUToLLVMTypeConverter &typeConverter,
     RewritePatternSet &patterns, PatternBenefit benefit) {
+  patterns.add<AllocOpConversion>(typeConverter, benefit);
   patterns.add<MakeTensorPtrOpConversion>(typeConverter, benefit);
   patterns.add<AdvanceOpConversion>(typeConverter, benefit);
   patterns.add<DotOpConversion>(typeConverter, benefit);
@@ -353,6 +484,11 @@ void mlir::triton::intel::populateTritonOpsToLLVMPatterns(
                                                           benefit);
   patterns.add<LoadStorePrefetchOpConversion<LoadOp>>(typeConverter, benefit);
   patterns.add<LoadStorePrefetchOpConversion<StoreOp>>(typeConverter, benefit);
+  // Accesses to shared local memory take precedence over 2D block accesses.
+  patterns.add<SharedMemoryLoadStoreOpConversion<LoadOp>>(
+      typeConverter, benefit.getBenefit() + 1);
+  patterns.add<SharedMemoryLoadStoreOpConversion<StoreOp>>(
+      typeConverter, benefit.getBenefit() + 1);
   patterns.add<GlueOpConversion>(typeConverter, benefit);
   patterns.add<ExtractOpConversion>(typeConverter, benefit);
 }
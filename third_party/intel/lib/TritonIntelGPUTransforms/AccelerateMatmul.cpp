@@ -11,6 +11,7 @@
 #include "triton/Dialect/Triton/IR/Utility.h"
 #include "triton/Dialect/TritonGPU/IR/Dialect.h"
 #include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/Debug.h"
 
 using namespace mlir;
 namespace tt = mlir::triton;
@@ -22,6 +23,8 @@ namespace mlir::triton::gpu::intel {
 #include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h.inc"
 } // namespace mlir::triton::gpu::intel
 
+#define DEBUG_TYPE "tritonintelgpu-accelerate-matmul"
+
 namespace {
 using tt::DotOp;
 using ttg::ConvertLayoutOp;
@@ -60,6 +63,108 @@ IntelDPASCapability getDPASCapability(DeviceArch arch) {
   return caps[(uint32_t)arch];
 }
 
+// Loads of an operand tile shared by several warps mostly hit in the cache,
+// so each duplicated load only costs a fraction of the first one.
+constexpr unsigned duplicatedLoadCostDivisor = 8;
+// Fixed cost of the barrier needed to exchange a tile through SLM.
+constexpr unsigned slmBarrierCost = 4096;
+
+/// Returns the operations of the backward slice of \p operand which are
+/// located in \p region, including its defining operation.
+SetVector<Operation *> getOperandSlice(Value operand, Region *region) {
+  SetVector<Operation *> slice;
+  Operation *defOp = operand.getDefiningOp();
+  if (!defOp || defOp->getParentRegion() != region)
+    return slice;
+
+  BackwardSliceOptions options;
+  options.omitBlockArguments = true;
+  options.filter = [region](Operation *op) {
+    return op->getParentRegion() == region;
+  };
+  getBackwardSlice(defOp, &slice, options);
+  slice.insert(defOp);
+  return slice;
+}
+
+/// Returns the estimated cost of feeding the operand \p opIdx of \p dotOp
+/// when it is replicated over \p copies warps.
+/// - an operand computed by another dot of \p chain stays in registers if
+///   it is not replicated, otherwise it is exchanged through SLM,
+/// - an operand loaded in the region of the dot (e.g. K and V in the loop of
+///   a flash attention kernel) is loaded by each warp using it,
+/// - an operand defined outside the region of the dot (e.g. Q in a flash
+///   attention kernel) is loaded once and is not accounted for.
+uint64_t getOperandCost(DotOp dotOp, unsigned opIdx, unsigned copies,
+                        const SetVector<Operation *> &chain) {
+  Value operand = opIdx == 0 ? dotOp.getA() : dotOp.getB();
+  auto tensorTy = cast<RankedTensorType>(operand.getType());
+  uint64_t bytes = tensorTy.getNumElements() *
+                   tensorTy.getElementType().getIntOrFloatBitWidth() / 8;
+
+  SetVector<Operation *> slice =
+      getOperandSlice(operand, dotOp->getParentRegion());
+  if (llvm::any_of(slice, [&](Operation *op) { return chain.contains(op); }))
+    return copies == 1 ? 0 : 2 * bytes + slmBarrierCost;
+
+  if (llvm::none_of(slice, [](Operation *op) {
+        return isa<tt::LoadOp, ttg::LocalLoadOp>(op);
+      }))
+    return 0;
+
+  return bytes + bytes * (copies - 1) / duplicatedLoadCostDivisor;
+}
+
+/// Returns the estimated cost of executing the dots of \p chain with the
+/// given \p warpsPerTile, or std::nullopt if a dot of the chain is too small
+/// to give a DPAS tile to each warp.
+std::optional<uint64_t>
+getChainCost(const SetVector<Operation *> &chain,
+             struct IntelDPASCapability dpasCap,
+             ArrayRef<unsigned> warpsPerTile) {
+  uint64_t cost = 0;
+  for (Operation *op : chain) {
+    auto dotOp = cast<DotOp>(op);
+    ArrayRef<int64_t> shape = dotOp.getType().getShape();
+    if (shape[0] < warpsPerTile[0] * dpasCap.repeatCount ||
+        shape[1] < warpsPerTile[1] * dpasCap.executionSize)
+      return std::nullopt;
+
+    // Operand A is replicated over the warps of a row, operand B over the
+    // warps of a column.
+    cost += getOperandCost(dotOp, 0, warpsPerTile[1], chain);
+    cost += getOperandCost(dotOp, 1, warpsPerTile[0], chain);
+  }
+  return cost;
+}
+
+/// Returns the warp tiling of the chained dots \p chain (e.g. the two dots of
+/// a flash attention kernel) with the lowest estimated cost. Row-only tilings
+/// are preferred, as they let a dot result feed the next dot in registers.
+SmallVector<unsigned>
+getChainedWarpsPerTile(const SetVector<Operation *> &chain,
+                       struct IntelDPASCapability dpasCap, unsigned numWarps) {
+  SmallVector<unsigned> ret{numWarps, 1};
+  std::optional<uint64_t> minCost;
+  for (unsigned rowWarps = numWarps; rowWarps >= 1; rowWarps /= 2) {
+    SmallVector<unsigned> warpsPerTile{rowWarps, numWarps / rowWarps};
+    std::optional<uint64_t> cost = getChainCost(chain, dpasCap, warpsPerTile);
+    LLVM_DEBUG({
+      llvm::dbgs() << "warpsPerTile = [" << warpsPerTile[0] << ", "
+                   << warpsPerTile[1] << "]: ";
+      if (cost)
+        llvm::dbgs() << "cost = " << *cost << "\n";
+      else
+        llvm::dbgs() << "invalid\n";
+    });
+    if (cost && (!minCost || *cost < *minCost)) {
+      minCost = cost;
+      ret = warpsPerTile;
+    }
+  }
+  return ret;
+}
+
 SmallVector<unsigned> getWarpsPerTile(tt::DotOp dotOp,
                                       struct IntelDPASCapability dpasCap,
                                       const ArrayRef<int64_t> shape,
@@ -68,10 +173,12 @@ SmallVector<unsigned> getWarpsPerTile(tt::DotOp dotOp,
     return op->getParentRegion() == dotOp->getParentRegion();
   };
   auto slices = mlir::getSlice(dotOp, {filter});
-  // TODO: revisit this in flash attention.
+  SetVector<Operation *> chain;
   for (Operation *op : slices)
-    if (isa<DotOp>(op) && (op != dotOp))
-      return {numWarps, 1};
+    if (isa<DotOp>(op))
+      chain.insert(op);
+  if (chain.size() > 1)
+    return getChainedWarpsPerTile(chain, dpasCap, numWarps);
 
   SmallVector<unsigned> ret{1, 1};
   SmallVector<int64_t> shapePerWarp{dpasCap.repeatCount, dpasCap.executionSize};
@@ -132,9 +239,14 @@ public:
     RankedTensorType oldAType = cast<RankedTensorType>(a.getType());
     RankedTensorType oldBType = cast<RankedTensorType>(b.getType());
 
+    // FP8 operands are distributed in the DPAS operand layout of their
+    // upconverted FP16 type and upconverted in registers.
+    Type dpasElemType = oldAType.getElementType();
+    if (ttgi::isUpconvertedFP8Type(dpasElemType))
+      dpasElemType = rewriter.getF16Type();
+
     IntelDPASCapability dpasCap = getDPASCapability(arch);
-    unsigned dpasElemBitWidths =
-        oldAType.getElementType().getIntOrFloatBitWidth();
+    unsigned dpasElemBitWidths = dpasElemType.getIntOrFloatBitWidth();
     unsigned opsPerChan = dpasCap.opsChanBitWidths / dpasElemBitWidths;
 
     SmallVector<unsigned> warpsPerTile =
@@ -165,6 +277,12 @@ public:
 
     a = rewriter.create<ttg::ConvertLayoutOp>(a.getLoc(), newAType, a);
     b = rewriter.create<ttg::ConvertLayoutOp>(b.getLoc(), newBType, b);
+    if (dpasElemType != oldAType.getElementType())
+      a = rewriter.create<tt::FpToFpOp>(
+          a.getLoc(), newAType.cloneWith(std::nullopt, dpasElemType), a);
+    if (dpasElemType != oldBType.getElementType())
+      b = rewriter.create<tt::FpToFpOp>(
+          b.getLoc(), newBType.cloneWith(std::nullopt, dpasElemType), b);
     DotOp newDot = rewriter.create<DotOp>(dotOp.getLoc(), newRetType, a, b,
                                           newAcc, dotOp.getInputPrecision(),
                                           dotOp.getMaxNumImpreciseAcc());
@@ -235,12 +235,13 @@ void distributeConvertLayoutOp(ttg::ConvertLayoutOp op, Value warpId,
       tt::PointerType::get(op.getSrc().getType(),
                            triton::TritonGEN::TritonGENMemorySpace::kWorkgroup);
 
-  // FIXME: allocOp may carry the size info.
   OpBuilder b(op);
-  auto baseType = tt::PointerType::get(
-      oldSrcType.getElementType(),
-      triton::TritonGEN::TritonGENMemorySpace::kCrossWorkgroup);
-  auto base = b.create<ttgi::AllocOp>(loc, baseType);
+  auto baseType =
+      tt::PointerType::get(oldSrcType.getElementType(),
+                           triton::TritonGEN::TritonGENMemorySpace::kWorkgroup);
+  int64_t size = oldSrcType.getNumElements() *
+                 oldSrcType.getElementTypeBitWidth() / 8;
+  auto base = b.create<ttgi::AllocOp>(loc, baseType, b.getI64IntegerAttr(size));
 
   SmallVector<Value> shape;
   shape.push_back(
@@ -273,6 +274,9 @@ void distributeConvertLayoutOp(ttg::ConvertLayoutOp op, Value warpId,
                                     dstOffsets, b.getDenseI32ArrayAttr({1, 0}));
   auto load = b.create<tt::LoadOp>(loc, loadPtr, tt::CacheModifier::NONE,
                                    tt::EvictionPolicy::NORMAL, false);
+  // Prevent the buffer from being overwritten (e.g. by the next iteration of
+  // an enclosing loop) before all warps have read it.
+  b.create<gpu::BarrierOp>(loc);
   op->replaceAllUsesWith(load->getResults());
   op->erase();
 }
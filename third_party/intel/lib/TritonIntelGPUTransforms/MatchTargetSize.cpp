@@ -50,6 +50,7 @@
 
 #include "intel/include/Dialect/TritonIntelGPU/IR/Dialect.h"
 #include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h"
+#include "intel/include/Dialect/TritonIntelGPU/Transforms/Utility.h"
 
 #include "triton/Dialect/Triton/IR/Dialect.h"
 
@@ -62,82 +63,26 @@ using namespace mlir;
 namespace tt = mlir::triton;
 namespace ttg = mlir::triton::gpu;
 namespace ttgi = mlir::triton::gpu::intel;
+using ttgi::TargetArchNativeSizes;
 
 #define DEBUG_TYPE "tritonintelgpu-match-target-size"
 
 namespace {
 
-// Encode the native operation sizes supported by the target architecture.
-class TargetArchNativeSizes {
-public:
-  struct DotShape {
-    DotShape(unsigned m, unsigned n, unsigned k) : m(m), n(n), k(k) {
-      assert(m != 0 && n != 0 && k != 0 && "expecting valid shape");
-    }
-
-    const unsigned m;
-    const unsigned n;
-    const unsigned k;
-  };
-
-  struct BlockMemShape {
-    BlockMemShape(unsigned rowsA, unsigned columnsA, unsigned rowsB,
-                  unsigned columnsB)
-        : rowsA(rowsA), columnsA(columnsA), rowsB(rowsB), columnsB(columnsB) {
-      assert(rowsA != 0 && columnsA != 0 && rowsB != 0 && columnsB != 0 &&
-             "expecting valid shape");
-    }
-
-    const unsigned rowsA;
-    const unsigned columnsA;
-    const unsigned rowsB;
-    const unsigned columnsB;
-  };
-
-  TargetArchNativeSizes() = default;
-
-  void setDotShape(unsigned bitWidth, DotShape &&shape) {
-    assert(!dotShapes.contains(bitWidth) && "Dot shape already set");
-    dotShapes.try_emplace(bitWidth, std::move(shape));
-  }
-  void setBlockMemShape(unsigned bitWidth, BlockMemShape &&shape) {
-    assert(!blockMemShapes.contains(bitWidth) &&
-           "Block memory access shape already set");
-    blockMemShapes.try_emplace(bitWidth, std::move(shape));
-  }
-  void setLoadStoreSize(unsigned size) { loadStoreSize = size; }
-  const DotShape &getDotShape(unsigned bitWidth) const {
-    assert(dotShapes.contains(bitWidth) &&
-           "No dot shape configured for bit width");
-    return dotShapes.at(bitWidth);
-  }
-  const BlockMemShape &getBlockMemShape(unsigned bitWidth) const {
-    assert(blockMemShapes.contains(bitWidth) &&
-           "No block memory access shape configured for bit width");
-    return blockMemShapes.at(bitWidth);
-  }
-  unsigned getLoadStoreSize() const { return loadStoreSize; }
-
-private:
-  /// Stores the natively supported dot shape per bitwidth of the operand data
-  /// type, e.g. 16 -> 8x16x16 (MxKxN) for [b]float16 on PVC.
-  llvm::SmallDenseMap<unsigned, DotShape> dotShapes;
-  /// Stores the natively supported shapes for 2D block reads of dot operands,
-  /// per element type bitwidth.
-  llvm::SmallDenseMap<unsigned, BlockMemShape> blockMemShapes;
-  unsigned loadStoreSize = 0;
-};
-
 class MatchTargetSizePass
     : public triton::gpu::intel::impl::TritonIntelGPUMatchTargetSizeBase<
           MatchTargetSizePass> {
 public:
   void runOnOperation() override {
-    initNativeOperationSizes();
-
     MLIRContext *ctx = &getContext();
     ModuleOp m = getOperation();
 
+    initNativeOperationSizes();
+    if (!nativeSizes.getMaxBlockHeight()) {
+      m.emitError("target architecture does not support 2D block accesses");
+      return signalPassFailure();
+    }
+
     // Collect the result layout of "interesting" `tt.dot` operations.
     // A candidate 'tt.dot' operation yields a tensor with a warp layout.
     m.walk([&](tt::DotOp dot) {
@@ -210,6 +155,8 @@ private:
 
   void recordRootSubSize(Type type);
   SmallVector<int64_t> getSubOpSize(RankedTensorType type) const;
+  SmallVector<int64_t> getDotOperandSubSize(RankedTensorType type,
+                                            unsigned opIdx) const;
   std::tuple<SmallVector<int64_t>, Type, SmallVector<int64_t>>
   getSubTypeAndShape(Type type) const;
 
@@ -419,19 +366,7 @@ public:
 };
 
 void MatchTargetSizePass::initNativeOperationSizes() {
-  // FIXME: sets the target dot shape natively supported by the target
-  // architecture using the target architecture information when available.
-  // These values works for PVC.
-
-  nativeSizes.setDotShape(8, {8, 16, 32});
-  nativeSizes.setDotShape(16, {8, 16, 16});
-  nativeSizes.setDotShape(32, {8, 16, 8});
-
-  nativeSizes.setBlockMemShape(8, {16, 64, 32, 32});
-  nativeSizes.setBlockMemShape(16, {32, 32, 32, 32});
-  nativeSizes.setBlockMemShape(32, {8, 8, 8, 16});
-
-  nativeSizes.setLoadStoreSize(512); // max 512DW;
+  nativeSizes = ttgi::getTargetArchNativeSizes(getOperation());
 }
 
 bool MatchTargetSizePass::isCandidate(Type type) const {
@@ -513,25 +448,15 @@ MatchTargetSizePass::getSubOpSize(RankedTensorType type) const {
   } break;
   case 2: {
     if (isa<ttgi::WarpEncodingAttr>(layout)) {
-      // 32 = 2 * 16(subgroupSize) which is for large load/store
-      subSize[1] = std::min(32L, shape[1]);
-      // FIXME: From gfxspec, max 2d block load height is 32
-      subSize[0] = std::min(32L, shape[0]);
+      // The tensors sharing a layout are split identically whatever their
+      // element type, so use the widest row of 16 bits elements (2 blocks of
+      // 16 columns) for all of them.
+      int64_t maxColumns = nativeSizes.getMaxBlockRowBytes() / 2;
+      int64_t maxRows = nativeSizes.getMaxBlockHeight();
+      subSize[1] = std::min(maxColumns, shape[1]);
+      subSize[0] = std::min(maxRows, shape[0]);
     } else if (auto dotLayout = dyn_cast<ttg::DotOperandEncodingAttr>(layout)) {
-      const TargetArchNativeSizes::BlockMemShape &memShape =
-          nativeSizes.getBlockMemShape(sizeInBits);
-      switch (dotLayout.getOpIdx()) {
-      case 0:
-        subSize[1] =
-            std::min(static_cast<int64_t>(memShape.columnsA), shape[1]);
-        subSize[0] = std::min(static_cast<int64_t>(memShape.rowsA), shape[0]);
-        break;
-      case 1:
-        subSize[1] =
-            std::min(static_cast<int64_t>(memShape.columnsB), shape[1]);
-        subSize[0] = std::min(static_cast<int64_t>(memShape.rowsB), shape[0]);
-        break;
-      }
+      return getDotOperandSubSize(type, dotLayout.getOpIdx());
     } else {
       llvm_unreachable("Unsupported layout");
     }
@@ -543,6 +468,54 @@ MatchTargetSizePass::getSubOpSize(RankedTensorType type) const {
   return subSize;
 }
 
+/// Return the shape of the 2D block reads of a dot operand. Among the shapes
+/// supported by the target, the one requiring the fewest reads is selected,
+/// favoring wider (multi-block) reads on ties.
+SmallVector<int64_t>
+MatchTargetSizePass::getDotOperandSubSize(RankedTensorType type,
+                                          unsigned opIdx) const {
+  ArrayRef<int64_t> shape = type.getShape();
+  const unsigned sizeInBits = type.getElementTypeBitWidth();
+  const unsigned sizeInBytes = sizeInBits / 8;
+  const TargetArchNativeSizes::DotShape &dotShape =
+      nativeSizes.getDotShape(sizeInBits);
+  const TargetArchNativeSizes::BlockMemShape &memShape =
+      nativeSizes.getBlockMemShape(sizeInBits);
+  const TargetArchNativeSizes::BlockIOShape &ioShape =
+      opIdx == 0 ? memShape.a : memShape.b;
+  const unsigned minHeight = opIdx == 0 ? dotShape.m : dotShape.k;
+  const unsigned maxHeight =
+      std::min(ioShape.maxHeight, nativeSizes.getMaxBlockHeight());
+  const unsigned maxSizeInBytes = nativeSizes.getLoadStoreSize() * 4;
+
+  SmallVector<int64_t> subSize{std::min<int64_t>(minHeight, shape[0]),
+                               std::min<int64_t>(ioShape.blockWidth, shape[1])};
+  int64_t minNumReads = std::numeric_limits<int64_t>::max();
+  for (unsigned arrayLength = 1; arrayLength <= ioShape.maxArrayLength;
+       arrayLength *= 2) {
+    unsigned width = ioShape.blockWidth * arrayLength;
+    if (width * sizeInBytes > nativeSizes.getMaxBlockRowBytes())
+      break;
+    for (unsigned height = minHeight; height <= maxHeight; height *= 2) {
+      if (height * width * sizeInBytes > maxSizeInBytes)
+        break;
+      int64_t rows = std::min<int64_t>(height, shape[0]);
+      int64_t columns = std::min<int64_t>(width, shape[1]);
+      int64_t numReads =
+          mlir::ceil(shape[0], rows) * mlir::ceil(shape[1], columns);
+      if (numReads <= minNumReads) {
+        minNumReads = numReads;
+        subSize = {rows, columns};
+      }
+    }
+  }
+
+  LLVM_DEBUG(llvm::dbgs() << "Dot operand " << opIdx << " " << type
+                          << " read in blocks of " << subSize[0] << "x"
+                          << subSize[1] << "\n");
+  return subSize;
+}
+
 /// return [shape, subType, subSize] for a tensor (or pointer to tensor)
 std::tuple<SmallVector<int64_t>, Type, SmallVector<int64_t>>
 MatchTargetSizePass::getSubTypeAndShape(Type type) const {
@@ -121,9 +121,6 @@ static void collectOpsToPipeline(scf::ForOp forOp,
                                  bool supportRegularPtr) {
   assert(loadOps.empty() && "Expecting an empty list of load operations");
 
-  ModuleOp moduleOp = forOp->getParentOfType<ModuleOp>();
-  mlir::triton::ModuleAxisInfoAnalysis axisInfoAnalysis(moduleOp);
-
   // We cannot use forOp.walk(...) here because we only want to visit the
   // operations in the loop body block.
   for (Operation &op : forOp) {
@@ -154,14 +151,19 @@ static Value getPredMask(RewriterBase &rewriter, Type typeLike,
                      : mask;
 }
 
-/// Function to mask operations during scheduling.
+/// Function to mask operations during scheduling. Block pointer loads are only
+/// issued speculatively when \p loadDistance is positive.
 static Operation *predicateOp(RewriterBase &rewriter, Operation *op,
-                              Value pred) {
+                              Value pred, int loadDistance) {
   OpBuilder::InsertionGuard guard(rewriter);
   if (mlir::isMemoryEffectFree(op) || isa<ttgi::PrefetchOp>(op))
     return op;
 
   if (auto loadOp = dyn_cast<tt::LoadOp>(op)) {
+    // Block pointer loads are lowered to 2D block reads, which are bounds
+    // checked by the HW, so they can be executed speculatively.
+    if (loadDistance > 0 && tt::isTensorPointerType(loadOp.getPtr().getType()))
+      return loadOp;
     rewriter.setInsertionPoint(loadOp);
     Value mask = getPredMask(rewriter, loadOp.getPtr().getType(),
                              loadOp.getMask(), pred);
@@ -220,8 +222,10 @@ static void addOps(scf::ForOp forOp, int stage,
 
 /// Create the schedule for a matmul loop. This is ad hoc based on how we know
 /// matmul loops should be pipelined and is not a generic scheduler.
+/// The loads are issued \p loadDistance iterations ahead of their uses, the
+/// pipeline expander carries the loaded values across iterations.
 static std::vector<std::pair<Operation *, unsigned>>
-createSchedule(scf::ForOp forOp, int numStages) {
+createSchedule(scf::ForOp forOp, int numStages, int loadDistance) {
   SmallVector<Operation *> prefetchOps;
   SmallVector<Operation *> loadOps;
   // Find the prefetch/load ops that will go respectively in stage 0 and stage
@@ -271,8 +275,18 @@ createSchedule(scf::ForOp forOp, int numStages) {
   // Schedule stage `numStage - 1` first.
   // Finally schedule the dot ops in stage `numStage - 1` so that they get
   // pre-fetched and play well with pretech pass.
-  addOps(forOp, numStages - 1, schedule,
-         [&](Operation *op) { return loadAndDeps.count(op); });
+  if (loadDistance == 0) {
+    addOps(forOp, numStages - 1, schedule,
+           [&](Operation *op) { return loadAndDeps.count(op); });
+  } else {
+    // Schedule the loads in stage `numStage - 1 - loadDistance`, the
+    // prefetches must stay ahead of the loads. The dependencies already
+    // scheduled in stage 1 must not be scheduled twice.
+    int loadStage = numStages - 1 - std::clamp(loadDistance, 0, numStages - 2);
+    addOps(forOp, loadStage, schedule, [&](Operation *op) {
+      return loadAndDeps.count(op) && !stage1deps.count(op);
+    });
+  }
 
   addOps(forOp, numStages - 1, schedule, [&](Operation *op) {
     return prefetchAndDeps.count(op) == 0 && stage1deps.count(op) == 0 &&
@@ -284,6 +298,7 @@ createSchedule(scf::ForOp forOp, int numStages) {
 
 bool ttgi::preProcessLoopAndGetSchedule(scf::ForOp &forOp, int numStages,
                                         bool supportRegularPtr,
+                                        int loadDistance,
                                         mlir::scf::PipeliningOption &options) {
   // 1. First collect "interesting" operations with a stage where to schedule
   // them. This gives a coarse scheduling for the loop.
@@ -306,7 +321,7 @@ bool ttgi::preProcessLoopAndGetSchedule(scf::ForOp &forOp, int numStages,
   // 3. Create the final schedule for the kernel loop. This will dictate the
   // stages and order of operations to the pipeline expander.
   std::vector<std::pair<Operation *, unsigned>> schedule =
-      createSchedule(forOp, numStages);
+      createSchedule(forOp, numStages, loadDistance);
 
   // 4. Fill out the pipeline options.
   options.getScheduleFn =
@@ -315,7 +330,10 @@ bool ttgi::preProcessLoopAndGetSchedule(scf::ForOp &forOp, int numStages,
         s = std::move(schedule);
       };
   options.peelEpilogue = false;
-  options.predicateFn = predicateOp;
+  options.predicateFn = [loadDistance](RewriterBase &rewriter, Operation *op,
+                                       Value pred) {
+    return predicateOp(rewriter, op, pred, loadDistance);
+  };
   options.supportDynamicLoops = true;
   options.annotateFn = [](Operation *op,
                           mlir::scf::PipeliningOption::PipelinerPart part,
@@ -6,7 +6,7 @@
 namespace mlir::triton::gpu::intel {
 
 bool preProcessLoopAndGetSchedule(scf::ForOp &forOp, int numStages,
-                                  bool supportRegularPtr,
+                                  bool supportRegularPtr, int loadDistance,
                                   mlir::scf::PipeliningOption &options);
 
 } // namespace mlir::triton::gpu::intel
@@ -1,4 +1,5 @@
 
+#include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/IR/TypeUtilities.h"
 #include "mlir/Interfaces/LoopLikeInterface.h"
 
@@ -18,15 +19,7 @@ namespace mlir::triton::gpu::intel {
 
 // Return true if the preconditions for pipelining the loop are met.
 static bool preCondition(scf::ForOp forOp) {
-  // Skip loop with distance > 1 for now.
-  // TODO: relax the constraint in the expander.
-  if (llvm::any_of(forOp.getBody()->getTerminator()->getOperands(),
-                   [](Value operand) {
-                     Operation *def = operand.getDefiningOp();
-                     return !def;
-                   }))
-    return false;
-  // Don't pipeline outer loops.
+  // Don't pipeline outer loops, their inner loops are pipelined instead.
   if (forOp
           ->walk([&](Operation *op) {
             if (isa<LoopLikeOpInterface>(op) && forOp.getOperation() != op)
@@ -38,16 +31,49 @@ static bool preCondition(scf::ForOp forOp) {
   return true;
 }
 
+// The pipeline expander requires the yielded values to be defined in the loop
+// body. Loop carried values with a distance greater than one (i.e. a region
+// iteration argument yielded as is, e.g. when rotating buffers) are therefore
+// materialized by a trivial select. The select is kept in the pipelined loop
+// and left to a later canonicalization to fold.
+static SmallVector<Operation *> materializeLoopCarriedValues(scf::ForOp forOp) {
+  SmallVector<Operation *> copies;
+  Operation *yieldOp = forOp.getBody()->getTerminator();
+  OpBuilder builder(yieldOp);
+  Value trueVal;
+  for (OpOperand &operand : yieldOp->getOpOperands()) {
+    auto arg = dyn_cast<BlockArgument>(operand.get());
+    if (!arg || arg.getOwner() != forOp.getBody())
+      continue;
+    if (!trueVal)
+      trueVal = builder.create<arith::ConstantIntOp>(forOp.getLoc(), 1, 1);
+    auto copy =
+        builder.create<arith::SelectOp>(forOp.getLoc(), trueVal, arg, arg);
+    operand.set(copy);
+    copies.push_back(copy);
+  }
+  if (trueVal)
+    copies.push_back(trueVal.getDefiningOp());
+  return copies;
+}
+
 static void pipelineLoop(scf::ForOp forOp, int numStages,
-                         bool supportRegularPtr) {
+                         bool supportRegularPtr, int loadDistance) {
   mlir::scf::PipeliningOption options;
   if (!preCondition(forOp))
     return;
 
+  SmallVector<Operation *> copies = materializeLoopCarriedValues(forOp);
   bool foundSchedule = ttgi::preProcessLoopAndGetSchedule(
-      forOp, numStages, supportRegularPtr, options);
-  if (!foundSchedule)
+      forOp, numStages, supportRegularPtr, loadDistance, options);
+  if (!foundSchedule) {
+    for (Operation *copy : copies) {
+      if (auto select = dyn_cast<arith::SelectOp>(copy))
+        select.replaceAllUsesWith(select.getTrueValue());
+      copy->erase();
+    }
     return;
+  }
 
   IRRewriter rewriter(forOp->getContext());
   rewriter.setInsertionPoint(forOp);
@@ -79,7 +105,7 @@ struct IntelGPUPipelinePass
     getOperation()->walk([&](scf::ForOp forOp) { loops.push_back(forOp); });
 
     for (scf::ForOp forOp : loops) {
-      pipelineLoop(forOp, numStages, supportRegularPtr);
+      pipelineLoop(forOp, numStages, supportRegularPtr, loadDistance);
     }
   }
 };
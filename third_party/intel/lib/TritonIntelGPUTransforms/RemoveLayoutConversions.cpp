@@ -863,7 +863,7 @@ bool LayoutPropagation::rewriteStoreOp(StoreOp storeOp) {
   Value newStorePtr = rewriter.create<MakeTensorPtrOp>(
       makeTensorPtrOp.getLoc(), newPtrType, makeTensorPtrOp.getBase(),
       makeTensorPtrOp.getShape(), makeTensorPtrOp.getStrides(),
-      makeTensorPtrOp.getOffsets(), rewriter.getDenseI32ArrayAttr({1, 0}));
+      makeTensorPtrOp.getOffsets(), makeTensorPtrOp.getOrderAttr());
 
   // The encoding of the StoreOp is updated with the new
   // operands:
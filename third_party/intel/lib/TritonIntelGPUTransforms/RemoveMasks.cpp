@@ -0,0 +1,436 @@
+//===- RemoveMasks.cpp - Remove the masks known to be all true -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass removing the masks of the loads and stores that
+// do not mask any element: the comparisons whose result is known from the
+// integer range analysis are folded, and the innermost loops whose masks only
+// fail in their last iterations are split into a mask-free steady state loop
+// and a masked tail loop.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "triton/Analysis/IntegerRange.h"
+#include "triton/Analysis/Utility.h"
+#include "triton/Dialect/Triton/IR/Dialect.h"
+
+#include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h"
+
+#include "llvm/Support/CheckedArithmetic.h"
+#include "llvm/Support/Debug.h"
+
+using namespace mlir;
+namespace tt = mlir::triton;
+
+namespace mlir::triton::gpu::intel {
+#define GEN_PASS_DEF_TRITONINTELGPUREMOVEMASKS
+#include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h.inc"
+} // namespace mlir::triton::gpu::intel
+
+#define DEBUG_TYPE "tritonintelgpu-remove-masks"
+
+namespace {
+
+/// An integer expression linear in the induction variable of a loop:
+///   ivCoeff * iv + sum(coeff * term) + offset
+/// where the terms are loop invariant scalars and the offset ranges over
+/// [minOffset, maxOffset] across the elements of a tensor.
+struct LinearExpr {
+  int64_t ivCoeff = 0;
+  SmallVector<std::pair<Value, int64_t>> terms;
+  int64_t minOffset = 0;
+  int64_t maxOffset = 0;
+
+  static LinearExpr getConstant(int64_t value) {
+    LinearExpr expr;
+    expr.minOffset = expr.maxOffset = value;
+    return expr;
+  }
+};
+
+std::optional<LinearExpr> addExprs(const LinearExpr &lhs,
+                                   const LinearExpr &rhs) {
+  std::optional<int64_t> ivCoeff = llvm::checkedAdd(lhs.ivCoeff, rhs.ivCoeff);
+  std::optional<int64_t> minOffset =
+      llvm::checkedAdd(lhs.minOffset, rhs.minOffset);
+  std::optional<int64_t> maxOffset =
+      llvm::checkedAdd(lhs.maxOffset, rhs.maxOffset);
+  if (!ivCoeff || !minOffset || !maxOffset)
+    return std::nullopt;
+  LinearExpr expr{*ivCoeff, lhs.terms, *minOffset, *maxOffset};
+  expr.terms.append(rhs.terms);
+  return expr;
+}
+
+std::optional<LinearExpr> scaleExpr(const LinearExpr &expr, int64_t factor) {
+  std::optional<int64_t> ivCoeff = llvm::checkedMul(expr.ivCoeff, factor);
+  std::optional<int64_t> minOffset = llvm::checkedMul(expr.minOffset, factor);
+  std::optional<int64_t> maxOffset = llvm::checkedMul(expr.maxOffset, factor);
+  if (!ivCoeff || !minOffset || !maxOffset)
+    return std::nullopt;
+  LinearExpr scaled{*ivCoeff, {}, *minOffset, *maxOffset};
+  if (factor < 0)
+    std::swap(scaled.minOffset, scaled.maxOffset);
+  for (auto [term, coeff] : expr.terms) {
+    std::optional<int64_t> termCoeff = llvm::checkedMul(coeff, factor);
+    if (!termCoeff)
+      return std::nullopt;
+    scaled.terms.emplace_back(term, *termCoeff);
+  }
+  return scaled;
+}
+
+std::optional<LinearExpr> getLinearExpr(Value value, scf::ForOp forOp,
+                                        DataFlowSolver &solver);
+
+/// Returns whether the addition, subtraction or multiplication \p op cannot
+/// wrap around its integer type for any elements of its operands, given their
+/// ranges. The linear expressions only model the operations which don't.
+bool cannotOverflow(Operation *op, DataFlowSolver &solver) {
+  std::optional<ConstantIntRanges> lhs =
+      tt::getIntegerRange(solver, op->getOperand(0));
+  std::optional<ConstantIntRanges> rhs =
+      tt::getIntegerRange(solver, op->getOperand(1));
+  if (!lhs || !rhs)
+    return false;
+  // The extreme results are reached at the bounds of the operands.
+  for (const APInt &lhsBound : {lhs->smin(), lhs->smax()}) {
+    for (const APInt &rhsBound : {rhs->smin(), rhs->smax()}) {
+      bool overflow = false;
+      if (isa<arith::AddIOp>(op))
+        (void)lhsBound.sadd_ov(rhsBound, overflow);
+      else if (isa<arith::SubIOp>(op))
+        (void)lhsBound.ssub_ov(rhsBound, overflow);
+      else
+        (void)lhsBound.smul_ov(rhsBound, overflow);
+      if (overflow) {
+        LLVM_DEBUG(llvm::dbgs() << "May overflow: " << *op << "\n");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Returns the linear expression computed by the operation defining \p value.
+std::optional<LinearExpr> getDefiningOpExpr(Value value, scf::ForOp forOp,
+                                            DataFlowSolver &solver) {
+  Operation *defOp = value.getDefiningOp();
+  auto getOperandExpr = [&](unsigned idx) {
+    return getLinearExpr(defOp->getOperand(idx), forOp, solver);
+  };
+  if (isa_and_nonnull<tt::SplatOp, tt::BroadcastOp, tt::ExpandDimsOp,
+                      arith::ExtSIOp>(defOp))
+    return getOperandExpr(0);
+  if (isa_and_nonnull<arith::AddIOp, arith::SubIOp, arith::MulIOp>(defOp) &&
+      !cannotOverflow(defOp, solver))
+    return std::nullopt;
+  if (isa_and_nonnull<arith::AddIOp, arith::SubIOp>(defOp)) {
+    std::optional<LinearExpr> lhs = getOperandExpr(0);
+    std::optional<LinearExpr> rhs = getOperandExpr(1);
+    if (rhs && isa<arith::SubIOp>(defOp))
+      rhs = scaleExpr(*rhs, -1);
+    if (!lhs || !rhs)
+      return std::nullopt;
+    return addExprs(*lhs, *rhs);
+  }
+  if (isa_and_nonnull<arith::MulIOp>(defOp)) {
+    APInt factor;
+    for (unsigned idx : {0, 1}) {
+      if (!matchPattern(defOp->getOperand(1 - idx), m_ConstantInt(&factor)))
+        continue;
+      if (std::optional<LinearExpr> expr = getOperandExpr(idx))
+        return scaleExpr(*expr, factor.getSExtValue());
+    }
+  }
+  return std::nullopt;
+}
+
+/// Returns \p value as a linear expression of the induction variable of
+/// \p forOp, or std::nullopt if it is not one.
+std::optional<LinearExpr> getLinearExpr(Value value, scf::ForOp forOp,
+                                        DataFlowSolver &solver) {
+  if (value == forOp.getInductionVar())
+    return LinearExpr{/*ivCoeff=*/1, {}, 0, 0};
+
+  APInt constant;
+  if (matchPattern(value, m_ConstantInt(&constant)))
+    return LinearExpr::getConstant(constant.getSExtValue());
+
+  // Loop invariant scalars are kept symbolic.
+  bool isInvariant = forOp.isDefinedOutsideOfLoop(value);
+  if (isInvariant && isa<IntegerType>(value.getType())) {
+    LinearExpr expr;
+    expr.terms.emplace_back(value, 1);
+    return expr;
+  }
+
+  if (std::optional<LinearExpr> expr =
+          getDefiningOpExpr(value, forOp, solver))
+    return expr;
+
+  // The elements of other loop invariant tensors (e.g. `tt.make_range`) are
+  // bounded by their range.
+  if (!isInvariant)
+    return std::nullopt;
+  std::optional<ConstantIntRanges> range = tt::getIntegerRange(solver, value);
+  if (!range)
+    return std::nullopt;
+  LinearExpr expr;
+  expr.minOffset = range->smin().getSExtValue();
+  expr.maxOffset = range->smax().getSExtValue();
+  return expr;
+}
+
+/// A comparison of a loop normalized into `expr <= 0`, which holds for all the
+/// elements of its operands in the iterations before:
+///   floordiv(-(sum(coeff * term) + maxOffset), ivCoeff) + 1
+struct SplitBound {
+  arith::CmpIOp cmpOp;
+  LinearExpr expr;
+};
+
+/// Returns the bound before which \p cmpOp is true for all elements, if it
+/// compares linear expressions of the induction variable of \p forOp and is
+/// true in the first iterations only.
+std::optional<SplitBound> getSplitBound(arith::CmpIOp cmpOp, scf::ForOp forOp,
+                                        DataFlowSolver &solver) {
+  // Normalize the comparison into `lhs - rhs + adjustment <= 0`.
+  Value lhs = cmpOp.getLhs(), rhs = cmpOp.getRhs();
+  int64_t adjustment = 0;
+  switch (cmpOp.getPredicate()) {
+  case arith::CmpIPredicate::slt:
+    adjustment = 1;
+    break;
+  case arith::CmpIPredicate::sle:
+    break;
+  case arith::CmpIPredicate::sgt:
+    std::swap(lhs, rhs);
+    adjustment = 1;
+    break;
+  case arith::CmpIPredicate::sge:
+    std::swap(lhs, rhs);
+    break;
+  default:
+    return std::nullopt;
+  }
+
+  std::optional<LinearExpr> lhsExpr = getLinearExpr(lhs, forOp, solver);
+  std::optional<LinearExpr> rhsExpr = getLinearExpr(rhs, forOp, solver);
+  if (!lhsExpr || !rhsExpr)
+    return std::nullopt;
+  std::optional<LinearExpr> negRhsExpr = scaleExpr(*rhsExpr, -1);
+  if (!negRhsExpr)
+    return std::nullopt;
+  std::optional<LinearExpr> expr = addExprs(*lhsExpr, *negRhsExpr);
+  if (!expr)
+    return std::nullopt;
+  // The comparison must become false as the induction variable grows.
+  if (expr->ivCoeff <= 0)
+    return std::nullopt;
+  std::optional<int64_t> maxOffset =
+      llvm::checkedAdd(expr->maxOffset, adjustment);
+  if (!maxOffset)
+    return std::nullopt;
+  expr->maxOffset = *maxOffset;
+  return SplitBound{cmpOp, *expr};
+}
+
+/// Collects the comparisons the masks of the loads and stores of \p forOp are
+/// the conjunction of.
+SetVector<arith::CmpIOp> getMaskComparisons(scf::ForOp forOp) {
+  SetVector<arith::CmpIOp> comparisons;
+  std::function<void(Value)> collect = [&](Value mask) {
+    if (!mask || !forOp->isAncestor(mask.getParentRegion()->getParentOp()))
+      return;
+    Operation *defOp = mask.getDefiningOp();
+    if (auto cmpOp = dyn_cast_or_null<arith::CmpIOp>(defOp))
+      comparisons.insert(cmpOp);
+    else if (isa_and_nonnull<arith::AndIOp>(defOp))
+      llvm::for_each(defOp->getOperands(), collect);
+    else if (isa_and_nonnull<tt::BroadcastOp, tt::ExpandDimsOp, tt::SplatOp>(
+                 defOp))
+      collect(defOp->getOperand(0));
+  };
+  forOp.walk([&](Operation *op) {
+    if (auto loadOp = dyn_cast<tt::LoadOp>(op))
+      collect(loadOp.getMask());
+    else if (auto storeOp = dyn_cast<tt::StoreOp>(op))
+      collect(storeOp.getMask());
+  });
+  return comparisons;
+}
+
+Value createBoolConstant(OpBuilder &builder, Location loc, Type type,
+                         bool value) {
+  Attribute attr = builder.getBoolAttr(value);
+  if (auto tensorTy = dyn_cast<RankedTensorType>(type))
+    attr = DenseElementsAttr::get(tensorTy, attr);
+  return builder.create<arith::ConstantOp>(loc, type, cast<TypedAttr>(attr));
+}
+
+Value createI64Constant(OpBuilder &builder, Location loc, int64_t value) {
+  return builder.create<arith::ConstantIntOp>(loc, value, 64);
+}
+
+Value extendToI64(OpBuilder &builder, Location loc, Value value) {
+  if (value.getType().isInteger(64))
+    return value;
+  return builder.create<arith::ExtSIOp>(loc, builder.getI64Type(), value);
+}
+
+/// Materializes the bound of \p splitBound in i64 before the loop.
+Value createBound(OpBuilder &builder, Location loc,
+                  const SplitBound &splitBound) {
+  const LinearExpr &expr = splitBound.expr;
+  Value negSum = createI64Constant(builder, loc, -expr.maxOffset);
+  for (auto [term, coeff] : expr.terms) {
+    Value product = builder.create<arith::MulIOp>(
+        loc, extendToI64(builder, loc, term),
+        createI64Constant(builder, loc, coeff));
+    negSum = builder.create<arith::SubIOp>(loc, negSum, product);
+  }
+  Value quotient = builder.create<arith::FloorDivSIOp>(
+      loc, negSum, createI64Constant(builder, loc, expr.ivCoeff));
+  return builder.create<arith::AddIOp>(loc, quotient,
+                                       createI64Constant(builder, loc, 1));
+}
+
+/// Splits \p forOp into a loop running the iterations before all the
+/// \p splitBounds, where their comparisons are replaced by true, followed by
+/// the original loop running the remaining iterations.
+void splitLoop(scf::ForOp forOp, ArrayRef<SplitBound> splitBounds) {
+  OpBuilder builder(forOp);
+  Location loc = forOp.getLoc();
+
+  // The steady state loop ends at the first iteration reaching a bound:
+  //   lb + ceildiv(max(bound - lb, 0), step) * step, clamped to ub.
+  Value bound = createBound(builder, loc, splitBounds.front());
+  for (const SplitBound &splitBound : splitBounds.drop_front())
+    bound = builder.create<arith::MinSIOp>(
+        loc, bound, createBound(builder, loc, splitBound));
+  Value lb = extendToI64(builder, loc, forOp.getLowerBound());
+  Value ub = extendToI64(builder, loc, forOp.getUpperBound());
+  Value step = extendToI64(builder, loc, forOp.getStep());
+  Value numIters = builder.create<arith::CeilDivSIOp>(
+      loc,
+      builder.create<arith::MaxSIOp>(
+          loc, builder.create<arith::SubIOp>(loc, bound, lb),
+          createI64Constant(builder, loc, 0)),
+      step);
+  Value split = builder.create<arith::AddIOp>(
+      loc, lb, builder.create<arith::MulIOp>(loc, numIters, step));
+  split = builder.create<arith::MinSIOp>(loc, split, ub);
+  Type ivType = forOp.getInductionVar().getType();
+  if (ivType != split.getType())
+    split = builder.create<arith::TruncIOp>(loc, ivType, split);
+
+  IRMapping mapping;
+  auto steadyLoop = cast<scf::ForOp>(builder.clone(*forOp, mapping));
+  steadyLoop.setUpperBound(split);
+  forOp.setLowerBound(split);
+  forOp.getInitArgsMutable().assign(steadyLoop.getResults());
+
+  for (const SplitBound &splitBound : splitBounds) {
+    auto cmpOp = cast<arith::CmpIOp>(
+        mapping.lookup(splitBound.cmpOp.getResult()).getDefiningOp());
+    builder.setInsertionPoint(cmpOp);
+    cmpOp.replaceAllUsesWith(
+        createBoolConstant(builder, cmpOp.getLoc(), cmpOp.getType(), true));
+    cmpOp.erase();
+  }
+}
+
+/// Replaces the comparisons of \p funcOp whose result is known by constants.
+void foldComparisons(tt::FuncOp funcOp, DataFlowSolver &solver) {
+  SmallVector<std::pair<arith::CmpIOp, bool>> knownComparisons;
+  funcOp.walk([&](arith::CmpIOp cmpOp) {
+    std::optional<ConstantIntRanges> range =
+        tt::getIntegerRange(solver, cmpOp.getResult());
+    if (range && range->umin() == range->umax())
+      knownComparisons.emplace_back(cmpOp, range->umin().getBoolValue());
+  });
+  for (auto [cmpOp, value] : knownComparisons) {
+    LLVM_DEBUG(llvm::dbgs() << "Folding " << cmpOp << " to " << value << "\n");
+    OpBuilder builder(cmpOp);
+    cmpOp.replaceAllUsesWith(
+        createBoolConstant(builder, cmpOp.getLoc(), cmpOp.getType(), value));
+    cmpOp.erase();
+  }
+}
+
+} // namespace
+
+class TritonIntelGPURemoveMasksPass
+    : public triton::gpu::intel::impl::TritonIntelGPURemoveMasksBase<
+          TritonIntelGPURemoveMasksPass> {
+public:
+  using triton::gpu::intel::impl::TritonIntelGPURemoveMasksBase<
+      TritonIntelGPURemoveMasksPass>::TritonIntelGPURemoveMasksBase;
+
+  void runOnOperation() override {
+    MLIRContext *context = &getContext();
+    ModuleOp mod = getOperation();
+
+    for (auto funcOp : mod.getOps<tt::FuncOp>()) {
+      std::unique_ptr<DataFlowSolver> solver = createDataFlowSolver();
+      solver->load<tt::IntegerRangeAnalysis>();
+      if (failed(solver->initializeAndRun(funcOp)))
+        return signalPassFailure();
+
+      // Collect the loops to split before changing the function, so that the
+      // analysis results stay valid.
+      SmallVector<std::pair<scf::ForOp, SmallVector<SplitBound>>> loops;
+      funcOp.walk([&](scf::ForOp forOp) {
+        // Only split innermost loops, to bound the code size increase.
+        bool isInnermost = true;
+        forOp.getBody()->walk([&](LoopLikeOpInterface) {
+          isInnermost = false;
+          return WalkResult::interrupt();
+        });
+        std::optional<ConstantIntRanges> step =
+            tt::getIntegerRange(*solver, forOp.getStep());
+        if (!isInnermost || !isa<IntegerType>(forOp.getStep().getType()) ||
+            !step || !step->smin().isStrictlyPositive())
+          return;
+
+        SmallVector<SplitBound> splitBounds;
+        for (arith::CmpIOp cmpOp : getMaskComparisons(forOp)) {
+          std::optional<ConstantIntRanges> range =
+              tt::getIntegerRange(*solver, cmpOp.getResult());
+          if (range && range->umin() == range->umax())
+            continue;
+          if (std::optional<SplitBound> splitBound =
+                  getSplitBound(cmpOp, forOp, *solver))
+            splitBounds.push_back(*splitBound);
+        }
+        if (!splitBounds.empty())
+          loops.emplace_back(forOp, std::move(splitBounds));
+      });
+
+      foldComparisons(funcOp, *solver);
+      for (auto &[forOp, splitBounds] : loops) {
+        LLVM_DEBUG(llvm::dbgs() << "Splitting loop " << forOp.getLoc() << " on "
+                                << splitBounds.size() << " comparisons\n");
+        splitLoop(forOp, splitBounds);
+      }
+    }
+
+    // Drop the masks that became constant.
+    RewritePatternSet patterns(context);
+    tt::LoadOp::getCanonicalizationPatterns(patterns, context);
+    tt::StoreOp::getCanonicalizationPatterns(patterns, context);
+    if (failed(applyPatternsAndFoldGreedily(mod, std::move(patterns))))
+      signalPassFailure();
+  }
+};
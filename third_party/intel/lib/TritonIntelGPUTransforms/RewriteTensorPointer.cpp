@@ -47,15 +47,44 @@ bool isDivisible(Value value, unsigned divisor) {
   if (auto extSIOp = value.getDefiningOp<arith::ExtSIOp>())
     return isDivisible(extSIOp->getOperand(0), divisor);
 
+  // Case 4: Value is defined by a multiplication, either factor being
+  // divisible is enough
+  if (auto mulIOp = value.getDefiningOp<arith::MulIOp>())
+    return isDivisible(mulIOp.getLhs(), divisor) ||
+           isDivisible(mulIOp.getRhs(), divisor);
+
   return false;
 }
 
+/// Check if the offsets of the tensor pointer along dimension \p dim are
+/// divisible by the divisor, both at creation and in every `tt.advance`
+/// operation derived from it.
+bool hasDivisibleOffsets(tt::MakeTensorPtrOp op, unsigned dim,
+                         unsigned divisor) {
+  if (!isDivisible(op.getOffsets()[dim], divisor))
+    return false;
+
+  WalkResult result = op->getParentOfType<tt::FuncOp>().walk(
+      [&](tt::AdvanceOp advanceOp) {
+        if (getMakeTensorPtrOp(advanceOp.getPtr()) == op &&
+            !isDivisible(advanceOp.getOffsets()[dim], divisor))
+          return WalkResult::interrupt();
+        return WalkResult::advance();
+      });
+  return !result.wasInterrupted();
+}
+
 /// Check if the tensor pointer should be removed. The tensor pointer should be
 /// removed if:
 ///   - the device architecture is not PVC
 ///   - the tensor pointer does not have DotEncoding with DpasEncoding parent
+///     nor DpasEncoding
+///   - the tensor pointer has DpasEncoding and is not only used by stores of
+///     16 or 32 bit row-major tiles
 ///   - the tensor pointer pitch is not divisible by Qword bitwidth
 ///   - the tensor pointer is not contiguous on memory
+///   - the tensor pointer is column-major and cannot be read with a transposed
+///     2D block load
 bool shouldRemove(tt::MakeTensorPtrOp &op, ttgi::DeviceArch deviceArch) {
   if (op->getParentOfType<ModuleOp>()->hasAttr("triton_gpu.is_lts"))
     return true;
@@ -67,27 +96,71 @@ bool shouldRemove(tt::MakeTensorPtrOp &op, ttgi::DeviceArch deviceArch) {
   auto ptrType = cast<tt::PointerType>(op.getType());
   auto tensorType = cast<RankedTensorType>(ptrType.getPointeeType());
 
-  if (!ttgi::hasDotDpasEncoding(tensorType))
+  // Block pointers with a DPAS encoding are used to write back the result of
+  // a dot with 2D block stores, block loads are only lowered for DPAS dot
+  // operands.
+  const bool isStorePtr = ttgi::hasDpasEncoding(tensorType);
+  if (!isStorePtr && !ttgi::hasDotDpasEncoding(tensorType))
     return true;
 
-  TypedValue<triton::PointerType> base = op.getBase();
-  Operation::operand_range shape = op.getShape();
   Operation::operand_range strides = op.getStrides();
-  Operation::operand_range offsets = op.getOffsets();
   ArrayRef<int32_t> order = op.getOrder();
-  ArrayRef<int64_t> tensorShape = tensorType.getShape();
+  if (strides.size() != 2 || order.size() != 2)
+    return true;
 
-  // TODO: support column-major tensor
-  // HW 2D block read instruction has restriction on pitch divisibility
-  if (strides.size() == 2) {
-    auto pitch = strides[0];
-    // PVC requires pitch to be a multiple of QWord(64 bits).
-    if (!isDivisible(pitch, 64 / tensorType.getElementTypeBitWidth()))
+  unsigned elemTypeBitWidth = tensorType.getElementTypeBitWidth();
+
+  // The 2D block loads are lowered for the DPAS operand type of the layout,
+  // this is not the case for operands upconverted in registers (e.g. FP8).
+  // The exception is an 8 bit operand B of a 16 bit DPAS (e.g. dequantized
+  // weights): the 8 bit VNNI transformed read already yields the elements of
+  // each work item in the DPAS layout order.
+  if (!isStorePtr) {
+    auto dotLayout =
+        cast<ttg::DotOperandEncodingAttr>(tensorType.getEncoding());
+    auto dpasLayout = cast<ttgi::DpasEncodingAttr>(dotLayout.getParent());
+    unsigned opsPerChannel = dpasLayout.getOpsPerChannel();
+    bool isNarrowOperandB = dotLayout.getOpIdx() == 1 &&
+                            elemTypeBitWidth == 8 && opsPerChannel == 2;
+    if (elemTypeBitWidth * opsPerChannel != 32 && !isNarrowOperandB)
       return true;
   }
 
+  if (isStorePtr) {
+    // The 2D block store writes row-major tiles of DPAS execution size columns,
+    // which is not supported for 8 bit elements.
+    if (order[0] != 1 || elemTypeBitWidth == 8)
+      return true;
+
+    // The tensor pointer must only be used to store values.
+    WalkResult result =
+        op->getParentOfType<tt::FuncOp>().walk([&](tt::LoadOp loadOp) {
+          if (tt::isTensorPointerType(loadOp.getPtr().getType()) &&
+              getMakeTensorPtrOp(loadOp.getPtr()) == op)
+            return WalkResult::interrupt();
+          return WalkResult::advance();
+        });
+    if (result.wasInterrupted())
+      return true;
+  }
+
+  // A column-major tensor is read as the transpose of a row-major one, using
+  // the 32 bit transposed 2D block load on pairs of 16 bit elements. This
+  // directly yields the DPAS operand layout (VNNI packed for operand B), but
+  // requires offsets along the contiguous dimension to be dword aligned.
+  bool isColumnMajor = (order[0] == 0);
+  if (isColumnMajor &&
+      (elemTypeBitWidth != 16 || !hasDivisibleOffsets(op, order[0], 2)))
+    return true;
+
+  // HW 2D block read instruction has restriction on pitch divisibility
+  // PVC requires pitch to be a multiple of QWord(64 bits).
+  Value pitch = strides[order[1]];
+  if (!isDivisible(pitch, 64 / elemTypeBitWidth))
+    return true;
+
   // HW 2D block read instruction only supports contiguous accessing.
-  auto fastChangeStride = strides[1];
+  Value fastChangeStride = strides[order[0]];
   if (auto stride =
           dyn_cast<arith::ConstantOp>(fastChangeStride.getDefiningOp())) {
     if (auto strideInt = dyn_cast<IntegerAttr>(stride.getValue()))
@@ -729,13 +802,8 @@ public:
     mod.walk([&](Operation *op) {
       if (llvm::isa<tt::MakeTensorPtrOp>(op)) {
         markTensorPointerForRemoval(op->getResult(0));
-      } else if (llvm::isa<tt::AdvanceOp, tt::LoadOp>(op)) {
+      } else if (llvm::isa<tt::AdvanceOp, tt::LoadOp, tt::StoreOp>(op)) {
         markTensorPointerForRemoval(op->getOperand(0));
-      } else if (llvm::isa<tt::StoreOp>(op)) {
-        // TODO: Block store should not be removed when 2d store is enabled
-        auto src = op->getOperand(0);
-        if (tt::isTensorPointerType(src.getType()))
-          valueToRemove.insert(src);
       } else if (auto forOp = dyn_cast<scf::ForOp>(op)) {
         for (auto arg : forOp.getInitArgs())
           markTensorPointerForRemoval(arg);
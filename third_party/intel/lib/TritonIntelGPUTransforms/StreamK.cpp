@@ -0,0 +1,516 @@
+//===- StreamK.cpp - Rewrite matmul kernels into Stream-K kernels ---------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a pass rewriting a kernel computing one output tile per
+// program into a persistent kernel: the full waves of tiles are computed data
+// parallel and the iterations of the K loop of the remaining tiles are split
+// evenly across the programs (Stream-K), the partial tiles being accumulated
+// with atomic additions.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/Analysis/SliceAnalysis.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+
+#include "triton/Dialect/Triton/IR/Dialect.h"
+
+#include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h"
+
+#include "llvm/Support/Debug.h"
+
+using namespace mlir;
+namespace tt = mlir::triton;
+
+namespace mlir::triton::gpu::intel {
+#define GEN_PASS_DEF_TRITONINTELGPUSTREAMK
+#include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h.inc"
+} // namespace mlir::triton::gpu::intel
+
+#define DEBUG_TYPE "tritonintelgpu-stream-k"
+
+namespace {
+
+/// The K loop of a matmul kernel and the accumulators it computes.
+struct KLoop {
+  scf::ForOp forOp;
+  /// The indices of the loop carried accumulators.
+  SmallVector<unsigned> accumulators;
+  /// The stores writing the accumulators back to memory.
+  SmallPtrSet<Operation *, 4> stores;
+};
+
+/// Returns true if \p value can be computed ahead of the tiles of the kernel,
+/// i.e. it neither depends on the program id nor has side effects.
+bool isTileInvariant(Value value) {
+  Operation *defOp = value.getDefiningOp();
+  if (!defOp)
+    return true;
+
+  SetVector<Operation *> slice;
+  BackwardSliceOptions options;
+  options.omitBlockArguments = true;
+  getBackwardSlice(defOp, &slice, options);
+  slice.insert(defOp);
+  return llvm::all_of(slice, [](Operation *op) {
+    return isPure(op) && !isa<tt::GetProgramIdOp>(op);
+  });
+}
+
+/// Returns the K loop of \p funcOp if the kernel can be rewritten into a
+/// Stream-K kernel.
+std::optional<KLoop> getKLoop(tt::FuncOp funcOp) {
+  if (!funcOp.isPublic() || !funcOp.getBody().hasOneBlock())
+    return std::nullopt;
+
+  Block &entry = funcOp.getBody().front();
+  KLoop kLoop;
+  for (auto forOp : entry.getOps<scf::ForOp>()) {
+    if (forOp.getBody()->getOps<tt::DotOp>().empty())
+      continue;
+    if (kLoop.forOp) {
+      LLVM_DEBUG(llvm::dbgs() << "More than one K loop\n");
+      return std::nullopt;
+    }
+    kLoop.forOp = forOp;
+  }
+  if (!kLoop.forOp)
+    return std::nullopt;
+
+  scf::ForOp forOp = kLoop.forOp;
+  if (!forOp.getInductionVar().getType().isInteger(32) ||
+      !isTileInvariant(forOp.getLowerBound()) ||
+      !isTileInvariant(forOp.getUpperBound()) ||
+      !isTileInvariant(forOp.getStep())) {
+    LLVM_DEBUG(llvm::dbgs() << "K loop bounds depend on the tile\n");
+    return std::nullopt;
+  }
+
+  // The loop carried values must either be accumulators, which start from
+  // zero for every partial tile, or pointers that can be advanced to the
+  // first iteration of a partial tile.
+  auto yieldOp = cast<scf::YieldOp>(forOp.getBody()->getTerminator());
+  for (auto [i, iterArg] : llvm::enumerate(forOp.getRegionIterArgs())) {
+    Value yielded = yieldOp.getOperand(i);
+    if (yielded == iterArg)
+      continue;
+
+    if (auto dotOp = yielded.getDefiningOp<tt::DotOp>();
+        dotOp && dotOp.getC() == iterArg) {
+      auto accType = cast<RankedTensorType>(dotOp.getType());
+      if (!accType.getElementType().isF32() ||
+          !matchPattern(forOp.getInitArgs()[i], m_AnyZeroFloat())) {
+        LLVM_DEBUG(llvm::dbgs() << "Unsupported accumulator: " << dotOp
+                                << "\n");
+        return std::nullopt;
+      }
+      kLoop.accumulators.push_back(i);
+      continue;
+    }
+
+    if (auto advanceOp = yielded.getDefiningOp<tt::AdvanceOp>();
+        advanceOp && advanceOp.getPtr() == iterArg &&
+        llvm::all_of(advanceOp.getOffsets(), [&](Value offset) {
+          return forOp.isDefinedOutsideOfLoop(offset);
+        }))
+      continue;
+
+    if (auto addPtrOp = yielded.getDefiningOp<tt::AddPtrOp>();
+        addPtrOp && addPtrOp.getPtr() == iterArg &&
+        forOp.isDefinedOutsideOfLoop(addPtrOp.getOffset()))
+      continue;
+
+    LLVM_DEBUG(llvm::dbgs() << "Unsupported loop carried value: " << yielded
+                            << "\n");
+    return std::nullopt;
+  }
+  if (kLoop.accumulators.empty())
+    return std::nullopt;
+
+  // The accumulators must be the only values written to memory, as the
+  // kernel body is executed once per partial tile.
+  auto isAccumulatorStore = [&](tt::StoreOp storeOp) {
+    auto result = dyn_cast<OpResult>(storeOp.getValue());
+    Value ptr = storeOp.getPtr();
+    return result && result.getOwner() == forOp &&
+           llvm::is_contained(kLoop.accumulators, result.getResultNumber()) &&
+           storeOp->getBlock() == &entry &&
+           (!tt::isTensorPointerType(ptr.getType()) ||
+            ptr.getDefiningOp<tt::MakeTensorPtrOp>());
+  };
+  WalkResult result = funcOp.walk([&](Operation *op) {
+    if (isa<tt::CallOp>(op))
+      return WalkResult::interrupt();
+    if (auto storeOp = dyn_cast<tt::StoreOp>(op);
+        storeOp && isAccumulatorStore(storeOp)) {
+      kLoop.stores.insert(op);
+      return WalkResult::advance();
+    }
+    return hasEffect<MemoryEffects::Write>(op) ? WalkResult::interrupt()
+                                               : WalkResult::advance();
+  });
+  if (result.wasInterrupted()) {
+    LLVM_DEBUG(llvm::dbgs() << "Kernel has unsupported side effects\n");
+    return std::nullopt;
+  }
+
+  for (unsigned i : kLoop.accumulators) {
+    if (llvm::any_of(forOp.getResult(i).getUsers(), [&](Operation *user) {
+          return !kLoop.stores.contains(user);
+        })) {
+      LLVM_DEBUG(llvm::dbgs() << "Accumulator is not stored as is\n");
+      return std::nullopt;
+    }
+  }
+
+  return kLoop;
+}
+
+/// Replaces the program ids (resp. numbers of programs) along the first axis
+/// with a single one defined at the beginning of the kernel, so that it is
+/// remapped to the tile index (resp. number of tiles) when the kernel body is
+/// cloned.
+void uniqueProgramIds(tt::FuncOp funcOp) {
+  Block &entry = funcOp.getBody().front();
+  OpBuilder builder(&entry, entry.begin());
+  Location loc = funcOp.getLoc();
+  auto axis =
+      tt::ProgramIDDimAttr::get(funcOp.getContext(), tt::ProgramIDDim::X);
+  auto programId =
+      builder.create<tt::GetProgramIdOp>(loc, builder.getI32Type(), axis);
+  auto numPrograms =
+      builder.create<tt::GetNumProgramsOp>(loc, builder.getI32Type(), axis);
+
+  funcOp.walk([&](Operation *op) {
+    if (op == programId || op == numPrograms)
+      return;
+    if (auto pidOp = dyn_cast<tt::GetProgramIdOp>(op);
+        pidOp && pidOp.getAxisAsInt() == 0) {
+      pidOp.getResult().replaceAllUsesWith(programId);
+      pidOp.erase();
+    } else if (auto numOp = dyn_cast<tt::GetNumProgramsOp>(op);
+               numOp && numOp.getAxisAsInt() == 0) {
+      numOp.getResult().replaceAllUsesWith(numPrograms);
+      numOp.erase();
+    }
+  });
+}
+
+/// Clones the computation of the tile invariant \p value at the insertion
+/// point of \p builder.
+Value cloneTileInvariant(OpBuilder &builder, Value value, IRMapping &mapping) {
+  Operation *defOp = value.getDefiningOp();
+  if (!defOp || mapping.contains(value))
+    return mapping.lookupOrDefault(value);
+
+  for (Value operand : defOp->getOperands())
+    cloneTileInvariant(builder, operand, mapping);
+  builder.clone(*defOp, mapping);
+  return mapping.lookup(value);
+}
+
+/// Returns the pointer offset \p offset multiplied by the (i32) number of
+/// iterations \p count.
+Value scaleOffset(OpBuilder &builder, Location loc, Value offset,
+                  Value count) {
+  auto elemType = cast<IntegerType>(getElementTypeOrSelf(offset));
+  if (elemType.getWidth() > 32)
+    count = builder.create<arith::ExtSIOp>(loc, elemType, count);
+  else if (elemType.getWidth() < 32)
+    count = builder.create<arith::TruncIOp>(loc, elemType, count);
+  if (auto tensorType = dyn_cast<RankedTensorType>(offset.getType()))
+    count = builder.create<tt::SplatOp>(loc, tensorType, count);
+  return builder.create<arith::MulIOp>(loc, offset, count);
+}
+
+/// Expands the 1D tensor \p value along all the dimensions of \p shape but
+/// \p dim and broadcasts it to \p shape.
+Value expandAndBroadcast(OpBuilder &builder, Location loc, Value value,
+                         unsigned dim, ArrayRef<int64_t> shape) {
+  Type elemType = cast<RankedTensorType>(value.getType()).getElementType();
+  SmallVector<int64_t> expandedShape{shape[dim]};
+  for (unsigned axis = 0; axis < shape.size(); ++axis) {
+    if (axis == dim)
+      continue;
+    expandedShape.insert(expandedShape.begin() + axis, 1);
+    value = builder.create<tt::ExpandDimsOp>(
+        loc, RankedTensorType::get(expandedShape, elemType), value, axis);
+  }
+  if (shape.size() == 1)
+    return value;
+  return builder.create<tt::BroadcastOp>(
+      loc, RankedTensorType::get(shape, elemType), value);
+}
+
+/// Returns the tensor of pointers and the mask equivalent to the block
+/// pointer created by \p op and loaded/stored with \p boundaryCheck.
+std::pair<Value, Value> getPointersAndMask(OpBuilder &builder,
+                                           tt::MakeTensorPtrOp op,
+                                           ArrayRef<int32_t> boundaryCheck) {
+  Location loc = op.getLoc();
+  auto ptrType = cast<tt::PointerType>(op.getType());
+  auto tensorType = cast<RankedTensorType>(ptrType.getPointeeType());
+  ArrayRef<int64_t> shape = tensorType.getShape();
+  Type i32Type = builder.getI32Type();
+  Type i64Type = builder.getI64Type();
+
+  Value offset, mask;
+  for (unsigned dim = 0; dim < shape.size(); ++dim) {
+    auto i32TensorType = RankedTensorType::get(shape[dim], i32Type);
+    auto i64TensorType = RankedTensorType::get(shape[dim], i64Type);
+    Value range = builder.create<tt::MakeRangeOp>(loc, i32TensorType, 0,
+                                                  shape[dim]);
+    Value index = builder.create<arith::AddIOp>(
+        loc, range,
+        builder.create<tt::SplatOp>(loc, i32TensorType, op.getOffsets()[dim]));
+    index = builder.create<arith::ExtSIOp>(loc, i64TensorType, index);
+
+    Value dimOffset = builder.create<arith::MulIOp>(
+        loc, index,
+        builder.create<tt::SplatOp>(loc, i64TensorType, op.getStrides()[dim]));
+    dimOffset = expandAndBroadcast(builder, loc, dimOffset, dim, shape);
+    offset = offset ? builder.create<arith::AddIOp>(loc, offset, dimOffset)
+                    : dimOffset;
+
+    if (!llvm::is_contained(boundaryCheck, dim))
+      continue;
+    // Block pointer offsets may be negative, the lower bound is checked too.
+    Value zero = builder.create<arith::ConstantOp>(
+        loc, builder.getZeroAttr(i64TensorType));
+    Value aboveLower = builder.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::sge, index, zero);
+    Value belowUpper = builder.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::slt, index,
+        builder.create<tt::SplatOp>(loc, i64TensorType, op.getShape()[dim]));
+    Value inBounds = builder.create<arith::AndIOp>(loc, aboveLower, belowUpper);
+    inBounds = expandAndBroadcast(builder, loc, inBounds, dim, shape);
+    mask = mask ? builder.create<arith::AndIOp>(loc, mask, inBounds) : inBounds;
+  }
+
+  Value ptr = builder.create<tt::SplatOp>(
+      loc, RankedTensorType::get(shape, op.getBase().getType()), op.getBase());
+  ptr = builder.create<tt::AddPtrOp>(loc, ptr.getType(), ptr, offset);
+  return {ptr, mask};
+}
+
+/// Adds the value stored by \p storeOp to memory with an atomic addition.
+void createAtomicAdd(OpBuilder &builder, tt::StoreOp storeOp,
+                     IRMapping &mapping) {
+  Value ptr = mapping.lookupOrDefault(storeOp.getPtr());
+  Value value = mapping.lookupOrDefault(storeOp.getValue());
+  Value mask = storeOp.getMask() ? mapping.lookupOrDefault(storeOp.getMask())
+                                 : Value();
+  if (tt::isTensorPointerType(ptr.getType()))
+    std::tie(ptr, mask) =
+        getPointersAndMask(builder, ptr.getDefiningOp<tt::MakeTensorPtrOp>(),
+                           storeOp.getBoundaryCheck());
+
+  builder.create<tt::AtomicRMWOp>(storeOp.getLoc(), value.getType(),
+                                  tt::RMWOp::FADD, ptr, value, mask,
+                                  tt::MemSemantic::RELAXED,
+                                  tt::MemSyncScope::GPU);
+}
+
+/// Clones the K loop restricted to the iterations [kBegin, kEnd), the loop
+/// carried pointers being advanced to the iteration \p kBegin.
+void cloneSplitKLoop(OpBuilder &builder, const KLoop &kLoop, Value kBegin,
+                     Value kEnd, IRMapping &mapping) {
+  scf::ForOp forOp = kLoop.forOp;
+  Location loc = forOp.getLoc();
+  auto yieldOp = cast<scf::YieldOp>(forOp.getBody()->getTerminator());
+
+  SmallVector<Value> initArgs;
+  for (auto [i, initArg] : llvm::enumerate(forOp.getInitArgs())) {
+    Value newInitArg = mapping.lookupOrDefault(initArg);
+    Value yielded = yieldOp.getOperand(i);
+    if (auto advanceOp = yielded.getDefiningOp<tt::AdvanceOp>()) {
+      auto offsets =
+          llvm::map_to_vector(advanceOp.getOffsets(), [&](Value offset) {
+            return builder
+                .create<arith::MulIOp>(loc, mapping.lookupOrDefault(offset),
+                                       kBegin)
+                .getResult();
+          });
+      newInitArg = builder.create<tt::AdvanceOp>(loc, newInitArg.getType(),
+                                                 newInitArg, offsets);
+    } else if (auto addPtrOp = yielded.getDefiningOp<tt::AddPtrOp>()) {
+      Value offset = scaleOffset(
+          builder, loc, mapping.lookupOrDefault(addPtrOp.getOffset()), kBegin);
+      newInitArg = builder.create<tt::AddPtrOp>(loc, newInitArg.getType(),
+                                                newInitArg, offset);
+    }
+    initArgs.push_back(newInitArg);
+  }
+
+  Value lowerBound = mapping.lookupOrDefault(forOp.getLowerBound());
+  Value step = mapping.lookupOrDefault(forOp.getStep());
+  Value newLowerBound = builder.create<arith::AddIOp>(
+      loc, lowerBound, builder.create<arith::MulIOp>(loc, kBegin, step));
+  Value newUpperBound = builder.create<arith::AddIOp>(
+      loc, lowerBound, builder.create<arith::MulIOp>(loc, kEnd, step));
+
+  auto newForOp = cast<scf::ForOp>(builder.clone(*forOp, mapping));
+  newForOp.setLowerBound(newLowerBound);
+  newForOp.setUpperBound(newUpperBound);
+  for (auto [operand, initArg] :
+       llvm::zip(newForOp.getInitArgsMutable(), initArgs))
+    operand.set(initArg);
+}
+
+/// Clones the kernel body \p ops to compute the tile \p tile. If \p kBegin and
+/// \p kEnd are set, only the iterations [kBegin, kEnd) of the K loop are
+/// computed and the accumulators are added atomically to the output.
+void cloneTile(OpBuilder &builder, ArrayRef<Operation *> ops,
+               const KLoop &kLoop, Value tile, Value numTiles,
+               Value kBegin = {}, Value kEnd = {}) {
+  bool isPartial = kBegin && kEnd;
+  IRMapping mapping;
+  for (Operation *op : ops) {
+    if (auto pidOp = dyn_cast<tt::GetProgramIdOp>(op);
+        pidOp && pidOp.getAxisAsInt() == 0) {
+      mapping.map(pidOp.getResult(), tile);
+    } else if (auto numOp = dyn_cast<tt::GetNumProgramsOp>(op);
+               numOp && numOp.getAxisAsInt() == 0) {
+      mapping.map(numOp.getResult(), numTiles);
+    } else if (isPartial && op == kLoop.forOp) {
+      cloneSplitKLoop(builder, kLoop, kBegin, kEnd, mapping);
+    } else if (isPartial && kLoop.stores.contains(op)) {
+      createAtomicAdd(builder, cast<tt::StoreOp>(op), mapping);
+    } else {
+      builder.clone(*op, mapping);
+    }
+  }
+}
+
+/// Rewrites the kernel \p funcOp into a persistent Stream-K kernel, taking
+/// the number of tiles as an extra trailing argument.
+void rewriteToStreamK(tt::FuncOp funcOp, const KLoop &kLoop) {
+  uniqueProgramIds(funcOp);
+
+  Block &entry = funcOp.getBody().front();
+  SmallVector<Operation *> ops = llvm::map_to_vector(
+      entry.without_terminator(), [](Operation &op) { return &op; });
+
+  Location loc = funcOp.getLoc();
+  OpBuilder builder(&entry, entry.begin());
+  Type i32Type = builder.getI32Type();
+  unsigned numTilesIdx = funcOp.getNumArguments();
+  funcOp.insertArgument(numTilesIdx, i32Type, DictionaryAttr(), loc);
+  Value numTiles = funcOp.getArgument(numTilesIdx);
+
+  auto axis =
+      tt::ProgramIDDimAttr::get(funcOp.getContext(), tt::ProgramIDDim::X);
+  Value programId = builder.create<tt::GetProgramIdOp>(loc, i32Type, axis);
+  Value numPrograms =
+      builder.create<tt::GetNumProgramsOp>(loc, i32Type, axis);
+  Value zero = builder.create<arith::ConstantIntOp>(loc, 0, 32);
+  Value one = builder.create<arith::ConstantIntOp>(loc, 1, 32);
+
+  // Number of iterations of the K loop per tile.
+  IRMapping boundsMapping;
+  scf::ForOp forOp = kLoop.forOp;
+  Value lowerBound =
+      cloneTileInvariant(builder, forOp.getLowerBound(), boundsMapping);
+  Value upperBound =
+      cloneTileInvariant(builder, forOp.getUpperBound(), boundsMapping);
+  Value step = cloneTileInvariant(builder, forOp.getStep(), boundsMapping);
+  Value numIters = builder.create<arith::MaxSIOp>(
+      loc,
+      builder.create<arith::CeilDivSIOp>(
+          loc, builder.create<arith::SubIOp>(loc, upperBound, lowerBound),
+          step),
+      zero);
+
+  // The full waves of tiles are computed data parallel, each program
+  // computing the tiles programId, programId + numPrograms, ...
+  Value numStreamKTiles =
+      builder.create<arith::RemUIOp>(loc, numTiles, numPrograms);
+  Value numDataParallelTiles =
+      builder.create<arith::SubIOp>(loc, numTiles, numStreamKTiles);
+  auto dataParallelLoop = builder.create<scf::ForOp>(
+      loc, programId, numDataParallelTiles, numPrograms);
+  {
+    OpBuilder::InsertionGuard guard(builder);
+    builder.setInsertionPoint(dataParallelLoop.getBody()->getTerminator());
+    cloneTile(builder, ops, kLoop, dataParallelLoop.getInductionVar(),
+              numTiles);
+  }
+
+  // The iterations of the remaining tiles are split evenly across the
+  // programs, each program computing the iterations [begin, end).
+  Value numDataParallelIters =
+      builder.create<arith::MulIOp>(loc, numDataParallelTiles, numIters);
+  Value numStreamKIters =
+      builder.create<arith::MulIOp>(loc, numStreamKTiles, numIters);
+  auto getFirstIter = [&](Value program) -> Value {
+    Value iters = builder.create<arith::DivUIOp>(
+        loc, builder.create<arith::MulIOp>(loc, program, numStreamKIters),
+        numPrograms);
+    return builder.create<arith::AddIOp>(loc, numDataParallelIters, iters);
+  };
+  Value begin = getFirstIter(programId);
+  Value end =
+      getFirstIter(builder.create<arith::AddIOp>(loc, programId, one));
+  builder.create<scf::WhileOp>(
+      loc, TypeRange{i32Type}, ValueRange{begin},
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        Value cond = b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::slt,
+                                             args[0], end);
+        b.create<scf::ConditionOp>(loc, cond, args);
+      },
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        Value iter = args[0];
+        Value tile = b.create<arith::DivUIOp>(loc, iter, numIters);
+        Value kBegin = b.create<arith::RemUIOp>(loc, iter, numIters);
+        Value kEnd = b.create<arith::MinUIOp>(
+            loc, numIters,
+            b.create<arith::AddIOp>(
+                loc, kBegin, b.create<arith::SubIOp>(loc, end, iter)));
+        cloneTile(b, ops, kLoop, tile, numTiles, kBegin, kEnd);
+        Value next = b.create<arith::AddIOp>(
+            loc, iter, b.create<arith::SubIOp>(loc, kEnd, kBegin));
+        b.create<scf::YieldOp>(loc, next);
+      });
+
+  for (Operation *op : llvm::reverse(ops))
+    op->erase();
+}
+
+} // namespace
+
+class TritonIntelGPUStreamKPass
+    : public triton::gpu::intel::impl::TritonIntelGPUStreamKBase<
+          TritonIntelGPUStreamKPass> {
+public:
+  using triton::gpu::intel::impl::TritonIntelGPUStreamKBase<
+      TritonIntelGPUStreamKPass>::TritonIntelGPUStreamKBase;
+
+  void runOnOperation() override {
+    ModuleOp mod = getOperation();
+    bool changed = false;
+    for (auto funcOp : mod.getOps<tt::FuncOp>()) {
+      std::optional<KLoop> kLoop = getKLoop(funcOp);
+      if (!kLoop) {
+        LLVM_DEBUG(llvm::dbgs() << "Cannot rewrite " << funcOp.getName()
+                                << " into a Stream-K kernel\n");
+        continue;
+      }
+      rewriteToStreamK(funcOp, *kLoop);
+      changed = true;
+    }
+
+    // Let the runtime know that the kernel takes the number of tiles as an
+    // extra argument.
+    if (changed)
+      mod->setAttr("triton_intel_gpu.stream-k",
+                   IntegerAttr::get(IntegerType::get(mod.getContext(), 32), 1));
+  }
+};
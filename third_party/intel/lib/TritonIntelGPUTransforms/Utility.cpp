@@ -62,11 +62,17 @@ DPASEngineType getDPASType(DotOp op) {
   auto cTy = cast<RankedTensorType>(op.getC().getType());
   auto dTy = cast<RankedTensorType>(op.getD().getType());
 
+  // The DPAS engine has no native FP8 support, FP8 operands (possibly of
+  // different kinds) are upconverted to FP16, which represents them exactly.
+  if (isUpconvertedFP8Type(aTy.getElementType()) &&
+      isUpconvertedFP8Type(bTy.getElementType()) &&
+      dTy.getElementType().isF32() && cTy.getElementType().isF32())
+    return DPASEngineType::FP32_FP32_FP16_FP16;
+
   if (aTy.getElementType() != bTy.getElementType() ||
       cTy.getElementType() != dTy.getElementType())
     return DPASEngineType::NOT_APPLICABLE;
 
-  // TODO: add more dpas supported data type.
   if (dTy.getElementType().isIntOrIndex()) {
     // Integer
     if (dTy.getElementType().getIntOrFloatBitWidth() == 32) {
@@ -98,6 +104,10 @@ DPASEngineType getDPASType(DotOp op) {
   return DPASEngineType::NOT_APPLICABLE;
 }
 
+bool isUpconvertedFP8Type(Type type) {
+  return isa<Float8E4M3FNUZType, Float8E5M2Type>(type);
+}
+
 std::optional<Attribute> inferSrcEncoding(Operation *op, Attribute encoding) {
   if (auto makeTensorPtrOp = dyn_cast<triton::MakeTensorPtrOp>(op))
     return encoding;
@@ -280,4 +290,77 @@ DeviceArch getDeviceArch(Operation *module) {
       .Case("xpu:DEVICE_ARCH.UNKNOWN", DeviceArch::UNKNOWN);
 }
 
+TargetArchNativeSizes getTargetArchNativeSizes(DeviceArch arch) {
+  TargetArchNativeSizes nativeSizes;
+  switch (arch) {
+  case DeviceArch::ATS:
+    // ATS has no 2D block reads.
+    nativeSizes.setDotShape(8, {8, 8, 32});
+    nativeSizes.setDotShape(16, {8, 8, 16});
+    nativeSizes.setDotShape(32, {8, 8, 8});
+    nativeSizes.setLoadStoreSize(512); // max 512DW;
+    break;
+  case DeviceArch::UNKNOWN:
+  case DeviceArch::PVC:
+    nativeSizes.setDotShape(8, {8, 16, 32});
+    nativeSizes.setDotShape(16, {8, 16, 16});
+    nativeSizes.setDotShape(32, {8, 16, 8});
+
+    // Blocks are 64 bytes wide (at most) and 32 rows high. Several blocks can
+    // be read side by side by one instruction as long as a row of all the
+    // blocks fits in 64 bytes.
+    nativeSizes.setBlockSize(32, 64);
+    nativeSizes.setBlockMemShape(8, {{32, 2, 32}, {16, 2, 32}});
+    nativeSizes.setBlockMemShape(16, {{16, 2, 32}, {16, 2, 32}});
+    nativeSizes.setBlockMemShape(32, {{8, 1, 8}, {16, 1, 8}});
+
+    nativeSizes.setLoadStoreSize(512); // max 512DW;
+    break;
+  }
+  return nativeSizes;
+}
+
+TargetArchNativeSizes getTargetArchNativeSizes(Operation *module) {
+  if (!module->hasAttr(triton::AttrTargetName))
+    return getTargetArchNativeSizes(DeviceArch::PVC);
+  return getTargetArchNativeSizes(getDeviceArch(module));
+}
+
+unsigned getPreferredThreadsPerWarp(ModuleOp mod) {
+  constexpr unsigned narrowThreadsPerWarp = 16;
+  constexpr unsigned wideThreadsPerWarp = 32;
+
+  // Dots run on the DPAS engine of PVC with 16 threads per warp only (its
+  // execution size). Dots lowered to FMAs replicate their operands over the
+  // threads of a warp, which is cheaper with fewer threads.
+  WalkResult hasDot =
+      mod.walk([](DotOp dotOp) { return WalkResult::interrupt(); });
+  if (hasDot.wasInterrupted())
+    return narrowThreadsPerWarp;
+
+  // Reductions along short axes would leave the threads of a wide warp idle
+  // in the butterfly reduction; longer axes are reduced with fewer SLM
+  // round-trips by wide warps.
+  WalkResult hasShortReduction = mod.walk([&](Operation *op) {
+    std::optional<unsigned> axis;
+    if (auto reduceOp = dyn_cast<ReduceOp>(op))
+      axis = reduceOp.getAxis();
+    else if (auto scanOp = dyn_cast<ScanOp>(op))
+      axis = scanOp.getAxis();
+    if (!axis)
+      return WalkResult::advance();
+
+    auto tensorTy = dyn_cast<RankedTensorType>(op->getOperand(0).getType());
+    if (tensorTy && tensorTy.getShape()[*axis] < wideThreadsPerWarp)
+      return WalkResult::interrupt();
+    return WalkResult::advance();
+  });
+  if (hasShortReduction.wasInterrupted())
+    return narrowThreadsPerWarp;
+
+  // Element-wise kernels and reductions along long axes are usually memory
+  // bound and benefit from the wider memory accesses of wide warps.
+  return wideThreadsPerWarp;
+}
+
 } // namespace mlir::triton::gpu::intel
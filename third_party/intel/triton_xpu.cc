@@ -1,3 +1,4 @@
+#include "mlir/Interfaces/LoopLikeInterface.h"
 #include "mlir/Pass/PassManager.h"
 #include "passes.h"
 
@@ -7,11 +8,13 @@
 #include "intel/include/Dialect/TritonGEN/IR/TritonGENDialect.h"
 #include "intel/include/Dialect/TritonIntelGPU/IR/Dialect.h"
 #include "intel/include/Dialect/TritonIntelGPU/Transforms/Passes.h"
+#include "intel/include/Dialect/TritonIntelGPU/Transforms/Utility.h"
 #include "intel/include/Target/LLVMIR/Dialect/TritonGEN/TritonGENToLLVMIRTranslation.h"
 #include "intel/include/Target/LLVMIR/LICM.h"
 #include "intel/include/TritonIntelGPUToLLVM/Passes.h"
 #include "intel/include/TritonToTritonGPUWarp/Passes.h"
 
+#include "triton/Dialect/Triton/IR/Dialect.h"
 #include "triton/Target/SPIRV/SPIRVTranslation.h"
 
 #include <pybind11/pybind11.h>
@@ -31,6 +34,10 @@ using ret = py::return_value_policy;
   m.def(name, [](mlir::PassManager &pm, ty0 val0, ty1 val1) {                  \
     pm.addPass(builder({val0, val1}));                                         \
   })
+#define ADD_PASS_WRAPPER_OPT_3(name, builder, ty0, ty1, ty2)                   \
+  m.def(name, [](mlir::PassManager &pm, ty0 val0, ty1 val1, ty2 val2) {        \
+    pm.addPass(builder({val0, val1, val2}));                                   \
+  })
 
 static uint32_t findKernels(llvm::Module &M,
                             std::set<llvm::Function *> &functions) {
@@ -47,6 +54,9 @@ static uint32_t findKernels(llvm::Module &M,
 void init_triton_intel_passes_ttir(py::module &&m) {
   ADD_PASS_WRAPPER_OPT_1("add_convert_to_ttgpuir_warp",
                          intel::createConvertTritonToTritonGPUWarp, unsigned);
+  ADD_PASS_WRAPPER_0("add_stream_k", gpu::intel::createTritonIntelGPUStreamK);
+  ADD_PASS_WRAPPER_0("add_remove_masks",
+                     gpu::intel::createTritonIntelGPURemoveMasks);
 }
 
 void init_triton_intel_passes_ttgpuir(py::module &&m) {
@@ -62,10 +72,11 @@ void init_triton_intel_passes_ttgpuir(py::module &&m) {
                      gpu::intel::createTritonIntelGPUAccelerateMatmul);
   ADD_PASS_WRAPPER_0("add_decompose_unsupported_conversions",
                      gpu::intel::createIntelDecomposeUnsupportedConversions);
-  ADD_PASS_WRAPPER_0("add_allocate_shared_memory",
-                     gpu::intel::createIntelAllocateSharedMemory);
-  ADD_PASS_WRAPPER_OPT_2("add_pipeline",
-                         gpu::intel::createTritonIntelGPUPipeline, int, bool);
+  ADD_PASS_WRAPPER_OPT_1("add_allocate_shared_memory",
+                         gpu::intel::createIntelAllocateSharedMemory, int);
+  ADD_PASS_WRAPPER_OPT_3("add_pipeline",
+                         gpu::intel::createTritonIntelGPUPipeline, int, bool,
+                         int);
   ADD_PASS_WRAPPER_0("add_remove_layout_conversions",
                      gpu::intel::createTritonIntelGPURemoveLayoutConversions);
   ADD_PASS_WRAPPER_0("add_rewrite_tensor_pointer",
@@ -102,6 +113,60 @@ void init_triton_intel(py::module &&m) {
       mod->setAttr("triton_gpu.is_lts", mlir::IntegerAttr::get(i1_ty, 1));
   });
 
+  m.def("get_preferred_threads_per_warp", [](mlir::ModuleOp mod) {
+    return gpu::intel::getPreferredThreadsPerWarp(mod);
+  });
+
+  // Describes which kinds of operations the module contains, so that only the
+  // passes which can change it are run.
+  m.def("get_module_features", [](mlir::ModuleOp mod) {
+    bool hasDot = false, hasLoop = false, hasReduce = false,
+         hasTensorPtr = false;
+    mod.walk([&](mlir::Operation *op) {
+      hasDot |= mlir::isa<DotOp>(op);
+      hasLoop |= mlir::isa<mlir::LoopLikeOpInterface>(op);
+      hasReduce |= mlir::isa<ReduceOp>(op);
+      hasTensorPtr |= mlir::isa<MakeTensorPtrOp>(op);
+    });
+    py::dict res;
+    res["dot"] = hasDot;
+    res["loop"] = hasLoop;
+    res["reduce"] = hasReduce;
+    res["tensor_ptr"] = hasTensorPtr;
+    return res;
+  });
+
+  // Describes the native operation sizes of the given architecture, keyed by
+  // the element bitwidth of the dot operands.
+  m.def("get_native_sizes", [](gpu::intel::DeviceArch arch) {
+    gpu::intel::TargetArchNativeSizes nativeSizes =
+        gpu::intel::getTargetArchNativeSizes(arch);
+    py::dict dotShapes, blockMemShapes;
+    for (unsigned bitWidth : {8, 16, 32}) {
+      const auto &dotShape = nativeSizes.getDotShape(bitWidth);
+      dotShapes[py::int_(bitWidth)] =
+          py::make_tuple(dotShape.m, dotShape.n, dotShape.k);
+      if (!nativeSizes.getMaxBlockHeight())
+        continue;
+      const auto &memShape = nativeSizes.getBlockMemShape(bitWidth);
+      auto toTuple = [](const auto &ioShape) {
+        return py::make_tuple(ioShape.blockWidth, ioShape.maxArrayLength,
+                              ioShape.maxHeight);
+      };
+      py::dict operands;
+      operands["a"] = toTuple(memShape.a);
+      operands["b"] = toTuple(memShape.b);
+      blockMemShapes[py::int_(bitWidth)] = operands;
+    }
+    py::dict res;
+    res["dot"] = dotShapes;
+    res["block_io"] = blockMemShapes;
+    res["max_block_height"] = nativeSizes.getMaxBlockHeight();
+    res["max_block_row_bytes"] = nativeSizes.getMaxBlockRowBytes();
+    res["load_store_size"] = nativeSizes.getLoadStoreSize();
+    return res;
+  });
+
   m.def("set_spv_target_triple", [](llvm::Module *mod) {
     // FIXME: Change triple back to spir64-unknown-unknown, when missing
     // SPIR-V 1.4 features are backported.